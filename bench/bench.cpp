@@ -0,0 +1,377 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  Host benchmarks of the library against the stubs in test/stub. Each
+//  benchmark reports the time per operation, the heap allocations per
+//  operation and the simulated I2C transfers per operation.
+//
+//  The results are written as JSON. If a baseline is given, the run fails
+//  when an operation is slower than the baseline by more than the threshold,
+//  or does more allocations or transfers than the baseline. With --no-time
+//  only the allocations and transfers are checked, since they don't depend
+//  on the machine.
+//
+//  Usage: isl1208_bench [--baseline file] [--output file] [--threshold ratio] [--no-time]
+//
+//========================================================================//
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <new>
+#include <chrono>
+#include "Arduino.h"
+#include "Wire.h"
+#include "ISL1208_RTC.h"
+#include "ISL1208_Calendar.h"
+#include "ISL1208_EventBuffer.h"
+
+#define BENCH_MAX_RESULTS   64
+#define BENCH_NAME_SIZE     40
+#define BENCH_MIN_NANOS     10000000LL  //each round of a benchmark runs for at least 10 ms
+#define BENCH_ROUNDS        5           //the fastest round is reported
+#define BENCH_EVENT_COUNT   256         //events in the event buffer benchmarks
+
+//========================================================================//
+//every heap allocation goes through these, so they can be counted
+
+static unsigned long allocationCount = 0;
+
+void* operator new (size_t size) {
+  allocationCount++;
+  void *memory = malloc(size);
+  if (memory == NULL) throw std::bad_alloc();
+  return memory;
+}
+
+void* operator new[] (size_t size) {
+  allocationCount++;
+  void *memory = malloc(size);
+  if (memory == NULL) throw std::bad_alloc();
+  return memory;
+}
+
+void operator delete (void *memory) noexcept {
+  free(memory);
+}
+
+void operator delete[] (void *memory) noexcept {
+  free(memory);
+}
+
+void operator delete (void *memory, size_t) noexcept {
+  free(memory);
+}
+
+void operator delete[] (void *memory, size_t) noexcept {
+  free(memory);
+}
+
+//========================================================================//
+
+struct BenchResult {
+  char name[BENCH_NAME_SIZE];
+  double nanosPerOp;
+  double allocsPerOp;
+  double transfersPerOp;
+};
+
+static BenchResult results[BENCH_MAX_RESULTS];
+static int resultCount = 0;
+static volatile uint32_t benchSink; //keeps the compiler from removing the work
+
+static TwoWire benchBus(20, 21);
+static ISL1208_RTC rtc(benchBus);
+
+//========================================================================//
+//runs an operation until it has taken long enough to be measured, then times
+//it a few more times with the same count and keeps the fastest round. the
+//operation is run once before, so first time allocations are not counted.
+
+template <typename Operation>
+static long long timeBench (Operation &operation, long long iterations) {
+  std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+  for (long long i = 0; i < iterations; i++) {
+    operation();
+  }
+
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+template <typename Operation>
+static void runBench (const char *name, Operation operation) {
+  long long iterations = 1;
+  long long elapsedNanos = 0;
+  unsigned long allocsBefore = 0;
+  unsigned long transfersBefore = 0;
+
+  operation();
+
+  while (true) {
+    allocsBefore = allocationCount;
+    transfersBefore = benchBus.transferCount;
+    elapsedNanos = timeBench(operation, iterations);
+    if (elapsedNanos >= BENCH_MIN_NANOS) break;
+    iterations *= 2;
+  }
+
+  BenchResult &result = results[resultCount++];
+  snprintf(result.name, sizeof(result.name), "%s", name);
+  result.allocsPerOp = (double) (allocationCount - allocsBefore) / iterations;
+  result.transfersPerOp = (double) (benchBus.transferCount - transfersBefore) / iterations;
+
+  for (byte i = 1; i < BENCH_ROUNDS; i++) {
+    long long roundNanos = timeBench(operation, iterations);
+    if (roundNanos < elapsedNanos) elapsedNanos = roundNanos;
+  }
+
+  result.nanosPerOp = (double) elapsedNanos / iterations;
+
+  printf("%-30s %10.1f ns/op %8.2f allocs/op %8.2f transfers/op\n", result.name,
+    result.nanosPerOp, result.allocsPerOp, result.transfersPerOp);
+}
+
+//========================================================================//
+
+static void benchConversions() {
+  runBench("bcdToDec", [] {
+    uint32_t sum = 0;
+    for (byte value = 0; value <= 0x99; value++) sum += rtc.bcdToDec(value);
+    benchSink = sum;
+  });
+
+  runBench("decToBcd", [] {
+    uint32_t sum = 0;
+    for (byte value = 0; value <= 99; value++) sum += rtc.decToBcd(value);
+    benchSink = sum;
+  });
+}
+
+//========================================================================//
+//parsing includes writing the registers, the same as on the board
+
+static void benchParsing() {
+  runBench("setTime_chars", [] {
+    benchSink = rtc.setTime("T26101902300511#");
+  });
+
+  runBench("setTime_String", [] {
+    benchSink = rtc.setTime(String("T26101902300511#"));
+  });
+
+  runBench("setAlarmTime_chars", [] {
+    benchSink = rtc.setAlarmTime("A101902300511#");
+  });
+
+  runBench("setAlarmTime_String", [] {
+    benchSink = rtc.setAlarmTime(String("A101902300511#"));
+  });
+}
+
+//========================================================================//
+
+static void benchStrings() {
+  runBench("getTimeString", [] { benchSink = rtc.getTimeString().length(); });
+  runBench("getDateString", [] { benchSink = rtc.getDateString().length(); });
+  runBench("getDayString", [] { benchSink = rtc.getDayString().length(); });
+  runBench("getDayString_n", [] { benchSink = rtc.getDayString(3).length(); });
+  runBench("getAlarmDayString", [] { benchSink = rtc.getAlarmDayString().length(); });
+  runBench("getAlarmDayString_n", [] { benchSink = rtc.getAlarmDayString(3).length(); });
+  runBench("getDateDayString", [] { benchSink = rtc.getDateDayString().length(); });
+  runBench("getDateDayString_n", [] { benchSink = rtc.getDateDayString(3).length(); });
+  runBench("getTimeDateString", [] { benchSink = rtc.getTimeDateString().length(); });
+  runBench("getTimeDateDayString", [] { benchSink = rtc.getTimeDateDayString().length(); });
+  runBench("getTimeDateDayString_n", [] { benchSink = rtc.getTimeDateDayString(3).length(); });
+}
+
+//========================================================================//
+
+static void benchEpoch() {
+  static ISL1208_DateTime dateTime = {26, 10, 19, 14, 30, 5, 1};
+  static ISL1208_DateTime otherTime = {99, 12, 31, 23, 59, 59, 4};
+  static uint32_t epoch = 0;
+
+  runBench("getEpoch", [] { benchSink = rtc.getEpoch(); });
+  runBench("toEpoch", [] { benchSink = rtc.toEpoch(); });
+
+  runBench("fromEpoch", [] {
+    rtc.fromEpoch(epoch);
+    epoch += 86399;
+    if (epoch > ISL1208_EPOCH_MAX) epoch = 0;
+    benchSink = rtc.dateValue;
+  });
+
+  runBench("Calendar_toEpoch", [] { benchSink = ISL1208_Calendar::toEpoch(dateTime); });
+
+  runBench("Calendar_fromEpoch", [] {
+    ISL1208_DateTime result;
+    ISL1208_Calendar::fromEpoch(epoch, result);
+    epoch += 86399;
+    if (epoch > ISL1208_EPOCH_MAX) epoch = 0;
+    benchSink = result.date;
+  });
+
+  runBench("Calendar_daysSince2000", [] { benchSink = ISL1208_Calendar::daysSince2000(dateTime.year, dateTime.month, dateTime.date); });
+  runBench("Calendar_dayOfWeek", [] { benchSink = ISL1208_Calendar::dayOfWeek(dateTime.year, dateTime.month, dateTime.date); });
+  runBench("Calendar_isValid", [] { benchSink = ISL1208_Calendar::isValid(dateTime); });
+
+  runBench("Calendar_addSeconds", [] {
+    ISL1208_DateTime result = dateTime;
+    benchSink = ISL1208_Calendar::addSeconds(result, 100000000L);
+  });
+
+  runBench("Calendar_diffSeconds", [] { benchSink = ISL1208_Calendar::diffSeconds(otherTime, dateTime); });
+  runBench("Calendar_compare", [] { benchSink = ISL1208_Calendar::compare(otherTime, dateTime); });
+}
+
+//========================================================================//
+//each operation fills the buffer and empties it again, so the time per
+//event is the time per operation divided by BENCH_EVENT_COUNT.
+
+static void benchEventBuffer() {
+  static ISL1208_Event storage[BENCH_EVENT_COUNT];
+  static ISL1208_Event decoded[BENCH_EVENT_COUNT];
+  static byte encoded[BENCH_EVENT_COUNT * ISL1208_EVENT_SIZE];
+  static ISL1208_EventBuffer buffer(rtc, storage, BENCH_EVENT_COUNT);
+
+  buffer.sync();
+
+  runBench("EventBuffer_stamp_pop_256", [] {
+    ISL1208_Event event;
+    uint32_t sum = 0;
+    for (uint16_t i = 0; i < BENCH_EVENT_COUNT; i++) buffer.stamp(i);
+    while (buffer.pop(event)) sum += event.code;
+    benchSink = sum;
+  });
+
+  runBench("EventBuffer_encode_decode_256", [] {
+    for (uint16_t i = 0; i < BENCH_EVENT_COUNT; i++) buffer.stamp(i);
+    uint16_t length = buffer.encode(encoded, sizeof(encoded));
+    benchSink = ISL1208_EventBuffer::decode(encoded, length, decoded, BENCH_EVENT_COUNT);
+  });
+}
+
+//========================================================================//
+
+static bool writeResults (const char *fileName) {
+  FILE *file = fopen(fileName, "w");
+
+  if (file == NULL) {
+    printf("Can't write %s\n", fileName);
+    return false;
+  }
+
+  fprintf(file, "{\n");
+
+  for (int i = 0; i < resultCount; i++) {
+    fprintf(file, "  \"%s\": {\"ns_per_op\": %.1f, \"allocs_per_op\": %.2f, \"transfers_per_op\": %.2f}%s\n",
+      results[i].name, results[i].nanosPerOp, results[i].allocsPerOp, results[i].transfersPerOp,
+      (i < (resultCount - 1)) ? "," : "");
+  }
+
+  fprintf(file, "}\n");
+  fclose(file);
+  return true;
+}
+
+//========================================================================//
+//reads the baseline written by writeResults(), one benchmark per line.
+//benchmarks missing from the baseline are not checked.
+
+static int checkBaseline (const char *fileName, double threshold, bool isTimeChecked) {
+  FILE *file = fopen(fileName, "r");
+  char line[256];
+  int failureCount = 0;
+
+  if (file == NULL) {
+    printf("Can't read %s\n", fileName);
+    return 1;
+  }
+
+  while (fgets(line, sizeof(line), file) != NULL) {
+    char name[BENCH_NAME_SIZE];
+    double nanosPerOp, allocsPerOp, transfersPerOp;
+
+    if (sscanf(line, " \"%39[^\"]\": {\"ns_per_op\": %lf, \"allocs_per_op\": %lf, \"transfers_per_op\": %lf}",
+      name, &nanosPerOp, &allocsPerOp, &transfersPerOp) != 4) {
+        continue;
+    }
+
+    for (int i = 0; i < resultCount; i++) {
+      if (strcmp(results[i].name, name) != 0) continue;
+
+      if (isTimeChecked && (results[i].nanosPerOp > (nanosPerOp * (1.0 + threshold)))) {
+        printf("FAIL %s: %.1f ns/op, baseline %.1f\n", name, results[i].nanosPerOp, nanosPerOp);
+        failureCount++;
+      }
+
+      if (results[i].allocsPerOp > (allocsPerOp + 0.005)) {
+        printf("FAIL %s: %.2f allocs/op, baseline %.2f\n", name, results[i].allocsPerOp, allocsPerOp);
+        failureCount++;
+      }
+
+      if (results[i].transfersPerOp > (transfersPerOp + 0.005)) {
+        printf("FAIL %s: %.2f transfers/op, baseline %.2f\n", name, results[i].transfersPerOp, transfersPerOp);
+        failureCount++;
+      }
+    }
+  }
+
+  fclose(file);
+  return failureCount;
+}
+
+//========================================================================//
+
+int main (int argc, char **argv) {
+  const char *baselineFile = NULL;
+  const char *outputFile = "bench_results.json";
+  double threshold = 0.5;
+  bool isTimeChecked = true;
+
+  for (int i = 1; i < argc; i++) {
+    if ((strcmp(argv[i], "--baseline") == 0) && (i + 1 < argc)) baselineFile = argv[++i];
+    else if ((strcmp(argv[i], "--output") == 0) && (i + 1 < argc)) outputFile = argv[++i];
+    else if ((strcmp(argv[i], "--threshold") == 0) && (i + 1 < argc)) threshold = atof(argv[++i]);
+    else if (strcmp(argv[i], "--no-time") == 0) isTimeChecked = false;
+    else {
+      printf("Usage: %s [--baseline file] [--output file] [--threshold ratio] [--no-time]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  benchBus.begin();
+  rtc.begin();
+  rtc.setTime("T26101902300511#");
+  rtc.setAlarmTime("A101902300511#");
+
+  benchConversions();
+  benchParsing();
+  benchStrings();
+  benchEpoch();
+  benchEventBuffer();
+
+  if (!writeResults(outputFile)) {
+    return 1;
+  }
+
+  if (baselineFile != NULL) {
+    int failureCount = checkBaseline(baselineFile, threshold, isTimeChecked);
+
+    if (failureCount > 0) {
+      printf("%d regressions against %s\n", failureCount, baselineFile);
+      return 1;
+    }
+
+    if (isTimeChecked) {
+      printf("No regressions against %s (threshold %.0f%%)\n", baselineFile, threshold * 100);
+    }
+    else {
+      printf("No allocation or transfer regressions against %s\n", baselineFile);
+    }
+  }
+
+  return 0;
+}
@@ -14,13 +14,15 @@
 //  Initial release: IST 11:49:42 AM, 27-05-2018, Sunday
 //  License: MIT
 //
-//  File last modified: +05:30 22:08:13 PM 09-12-2021, Thursday
+//  File last modified: +05:30 11:02:15 AM 19-10-2026, Monday
 //
 //========================================================================//
 
 #include <ISL1208_RTC.h>
+#include <ISL1208_Console.h>
 
 ISL1208_RTC myRtc = ISL1208_RTC();  //create a new object
+ISL1208_Console myConsole(myRtc, Serial);  //command console on the serial port
 
 //========================================================================//
 //Arduino setup function executes once
@@ -45,147 +47,11 @@ void setup() {
 //infinite loop
 
 void loop() {
-  String inputString = "";
-  String commandString = "";
-  String firstParam = "";
-  String secondParam = "";
-  String thirdParam = "";
-
   //send your commands and parameters from the serial monitor.
-  //all items are separated by single whitespace.
-  //you can send up to 3 parameters.
-  if (Serial.available()) {  //monitor the serial interface
-    inputString = Serial.readString();  //read the contents of serial buffer as string
-    Serial.println();
-    Serial.print("Input String : ");
-    Serial.println(inputString);
-
-    //-------------------------------------------------------------------------//
-    //the follwing loop extracts the commands and parameters separated by whitespace.
-
-    uint8_t posCount = 0;  //the position token of each whitespace
-    int indexOfSpace = 0;  //locations of the whitespaces
-
-    while (inputString.indexOf(" ") != -1) { //loop until all whitespace chars are found
-      indexOfSpace = inputString.indexOf(" ");  //get the position of first whitespace
-      if (indexOfSpace != -1) {  //if a whitespace is found
-        if (posCount == 0) //the first one will be command string
-          commandString = inputString.substring(0, indexOfSpace); //end char is exclusive
-        if (posCount == 1) //second will be second param
-          firstParam = inputString.substring(0, indexOfSpace);
-        if (posCount == 2) //and so on
-          secondParam = inputString.substring(0, indexOfSpace);
-        else if (posCount == 3)
-          thirdParam = inputString.substring(0, indexOfSpace);
-        inputString = inputString.substring(indexOfSpace+1);  //trim the input string
-        posCount++;
-      }
-    }
-
-    //saves the last part of the string if no more whitespace is found.
-    if (posCount == 0) //means there's just the command
-      commandString = inputString;
-    if (posCount == 1)
-      firstParam = inputString;
-    if (posCount == 2)
-      secondParam = inputString;
-    if (posCount == 3)
-      thirdParam = inputString;
-
-    //-------------------------------------------------------------------------//
-    //separate and print the received command and parameters.
-
-    Serial.print("Command string = ");
-    Serial.println(commandString);
-
-    if (firstParam.length() > 0) {  //only print if there's a valid first parameter
-      Serial.print("First param = ");
-      Serial.println(firstParam);
-    }
-
-    if (secondParam.length() > 0) {  //same for other parameters
-      Serial.print("Second param = ");
-      Serial.println(secondParam);
-    }
-
-    if (thirdParam.length() > 0) {
-      Serial.print("Third param = ");
-      Serial.println(thirdParam);
-    }
-
-    Serial.println();
-
-    //-------------------------------------------------------------------------//
-    //prints the time
-
-    if (commandString == "printtime") {
-      myRtc.printTime();
-    }
-
-    //-------------------------------------------------------------------------//
-    //prints the alarm time
-
-    else if (commandString == "printalarmtime") {
-      myRtc.printAlarmTime();
-    }
-
-    //-------------------------------------------------------------------------//
-    //send a time string to set time
-
-    else if (commandString == "settime") {
-      myRtc.setTime(firstParam);  //first param should be time string
-    }
-
-    //-------------------------------------------------------------------------//
-    //send a time string to set alarm
-
-    else if (commandString == "setalarm") {
-      myRtc.setAlarmTime(firstParam);  //first param should be time string
-    }
-
-    //-------------------------------------------------------------------------//
-    //prints formatted date
-
-    else if (commandString == "printdate") {
-      Serial.println(myRtc.getDateString());
-    }
-
-    //-------------------------------------------------------------------------//
-    //prints date and day
-
-    else if (commandString == "printdateday") {
-      Serial.println(myRtc.getDateDayString());
-    }
-
-    //-------------------------------------------------------------------------//
-    //prints day
-
-    else if (commandString == "printday") {
-      Serial.println(myRtc.getDayString());
-    }
-
-    //-------------------------------------------------------------------------//
-    //prints formatted time and date
-
-    else if (commandString == "printtimedate") {
-      Serial.println(myRtc.getTimeDateString());
-    }
-
-    //-------------------------------------------------------------------------//
-    //prints formatted time, data and day
-
-    else if (commandString == "printtimedateday") {
-      Serial.println(myRtc.getTimeDateDayString());
-    }
-
-    //-------------------------------------------------------------------------//
-    //prints formatted time, data and day
-
-    else {
-      Serial.println("Unknown command.");
-      Serial.println();
-    }
-  }
+  //all items are separated by single whitespace and the line must end
+  //with NL. you can send up to 3 parameters. see ISL1208_Console.cpp for
+  //the list of commands.
+  myConsole.poll();  //returns immediately if there's no complete line
 }
 
 //========================================================================//
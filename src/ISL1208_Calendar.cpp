@@ -0,0 +1,195 @@
+
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  ISL1208 is an RTC from Intersil. This is an Arduino compatible
+//  library for ISL1208.
+//
+//  Filename: ISL1208_Calendar.cpp
+//  Description: Part of ISL1208 RTC library.
+//  Library version: 1.4.7
+//  Author: Vishnu Mohanan (@vishnumaiea)
+//  Source: https://github.com/vishnumaiea/ISL1208-RTC-Library
+//  Initial release: IST 11:49:42 AM, 27-05-2018, Sunday
+//  License: MIT
+//
+//  File last modified: +05:30 07:24:51 PM 19-10-2026, Monday
+//
+//========================================================================//
+
+#include "ISL1208_Calendar.h"
+
+//========================================================================//
+//days in each month and days before each month in a non-leap year
+
+static const byte daysInMonthTable[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+static const uint16_t daysBeforeMonthTable[12] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+
+//========================================================================//
+//every year from 2000 to 2099 that is divisible by 4 is a leap year.
+//2000 is a leap year because it is divisible by 400.
+
+bool ISL1208_Calendar::isLeapYear (byte year) {
+  return ((year & 3) == 0);
+}
+
+//========================================================================//
+//returns 0 for an invalid month.
+
+byte ISL1208_Calendar::daysInMonth (byte year, byte month) {
+  if ((month < 1) || (month > 12)) {
+    return 0;
+  }
+
+  if ((month == 2) && isLeapYear(year)) {
+    return 29;
+  }
+
+  return daysInMonthTable[month - 1];
+}
+
+//========================================================================//
+
+bool ISL1208_Calendar::isValid (const ISL1208_DateTime &dateTime) {
+  if ((dateTime.year > 99) || (dateTime.hour > 23) || (dateTime.minute > 59) || (dateTime.second > 59) || (dateTime.day > 6)) {
+    return false;
+  }
+
+  return ((dateTime.date >= 1) && (dateTime.date <= daysInMonth(dateTime.year, dateTime.month)));
+}
+
+//========================================================================//
+//the date must be valid. an invalid month returns 0xFFFF instead of reading
+//outside the table.
+
+uint16_t ISL1208_Calendar::daysSince2000 (byte year, byte month, byte date) {
+  if ((month < 1) || (month > 12)) {
+    return 0xFFFF;
+  }
+
+  uint16_t dayCount = (uint16_t) year * 365 + ((year + 3) / 4); //days before this year, including the leap days
+  dayCount += daysBeforeMonthTable[month - 1];
+
+  if (isLeapYear(year) && (month > 2)) { //leap day of this year
+    dayCount++;
+  }
+
+  return dayCount + date - 1;
+}
+
+//========================================================================//
+//2000-01-01 was a Saturday (6).
+
+byte ISL1208_Calendar::dayOfWeek (byte year, byte month, byte date) {
+  return (daysSince2000(year, month, date) + 6) % 7;
+}
+
+//========================================================================//
+//the day of the week in the snapshot is not used. all the other values are
+//checked, so a snapshot from a corrupted register can't give a wrong time.
+
+uint32_t ISL1208_Calendar::toEpoch (const ISL1208_DateTime &dateTime) {
+  if ((dateTime.year > 99) || (dateTime.date < 1) || (dateTime.date > daysInMonth(dateTime.year, dateTime.month)) ||
+    (dateTime.hour > 23) || (dateTime.minute > 59) || (dateTime.second > 59)) {
+      return ISL1208_EPOCH_INVALID;
+  }
+
+  uint32_t dayCount = daysSince2000(dateTime.year, dateTime.month, dateTime.date);
+  return (dayCount * 86400) + ((uint32_t) dateTime.hour * 3600) + ((uint16_t) dateTime.minute * 60) + dateTime.second;
+}
+
+//========================================================================//
+//the day of the week is also calculated. the snapshot is left unchanged if
+//the time is after 2099.
+
+bool ISL1208_Calendar::fromEpoch (uint32_t epochTime, ISL1208_DateTime &dateTime) {
+  if (epochTime > ISL1208_EPOCH_MAX) {
+    return false;
+  }
+
+  uint32_t dayCount = epochTime / 86400;
+  uint32_t daySeconds = epochTime % 86400;
+
+  dateTime.day = (dayCount + 6) % 7;
+
+  //every 4 years have 1461 days, and the first year of each group is a leap year
+  dateTime.year = (dayCount / 1461) * 4;
+  dayCount %= 1461;
+
+  if (dayCount >= 366) {
+    dayCount -= 366;
+    dateTime.year += 1 + (dayCount / 365);
+    dayCount %= 365;
+  }
+
+  byte month = 12;
+  byte leapDay = isLeapYear(dateTime.year) ? 1 : 0;
+
+  while ((month > 1) && (dayCount < (uint32_t) (daysBeforeMonthTable[month - 1] + ((month > 2) ? leapDay : 0)))) {
+    month--;
+  }
+
+  dayCount -= daysBeforeMonthTable[month - 1] + ((month > 2) ? leapDay : 0);
+
+  dateTime.month = month;
+  dateTime.date = dayCount + 1;
+  dateTime.hour = daySeconds / 3600;
+  dateTime.minute = (daySeconds % 3600) / 60;
+  dateTime.second = daySeconds % 60;
+  return true;
+}
+
+//========================================================================//
+//the snapshot is left unchanged if it is invalid or the result is not
+//within 2000 to 2099.
+
+bool ISL1208_Calendar::addSeconds (ISL1208_DateTime &dateTime, int32_t duration) {
+  uint32_t epochTime = toEpoch(dateTime);
+
+  if (epochTime == ISL1208_EPOCH_INVALID) {
+    return false;
+  }
+
+  if (duration < 0) {
+    uint32_t magnitude = (uint32_t) (-(duration + 1)) + 1; //avoids overflow for the most negative value
+
+    if (magnitude > epochTime) {
+      return false;
+    }
+
+    epochTime -= magnitude;
+  }
+  else {
+    if ((uint32_t) duration > (ISL1208_EPOCH_MAX - epochTime)) {
+      return false;
+    }
+
+    epochTime += duration;
+  }
+
+  fromEpoch(epochTime, dateTime);
+  return true;
+}
+
+//========================================================================//
+//the difference can be up to 68 years either way. both snapshots must be
+//valid.
+
+int32_t ISL1208_Calendar::diffSeconds (const ISL1208_DateTime &first, const ISL1208_DateTime &second) {
+  return (int32_t) (toEpoch(first) - toEpoch(second));
+}
+
+//========================================================================//
+//an invalid snapshot is later than any valid one.
+
+int8_t ISL1208_Calendar::compare (const ISL1208_DateTime &first, const ISL1208_DateTime &second) {
+  uint32_t firstEpoch = toEpoch(first);
+  uint32_t secondEpoch = toEpoch(second);
+
+  if (firstEpoch < secondEpoch) return -1;
+  if (firstEpoch > secondEpoch) return 1;
+  return 0;
+}
+
+//========================================================================//
@@ -0,0 +1,59 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  ISL1208 is an RTC from Intersil. This is an Arduino compatible
+//  library for ISL1208.
+//
+//  Filename: ISL1208_Calendar.h
+//  Description: Header file for the calendar functions of ISL1208_RTC.
+//  Library version: 1.4.7
+//  Author: Vishnu Mohanan (@vishnumaiea)
+//  Source: https://github.com/vishnumaiea/ISL1208-RTC-Library
+//  Initial release: IST 11:49:42 AM, 27-05-2018, Sunday
+//  License: MIT
+//
+//  File last modified: +05:30 07:24:51 PM 19-10-2026, Monday
+//
+//========================================================================//
+
+#include <stdint.h>
+#include <Arduino.h>
+
+#ifndef _ISL1208_CALENDAR_H_
+#define _ISL1208_CALENDAR_H_
+
+//========================================================================//
+
+#define ISL1208_EPOCH_MAX     3155759999UL  //last second of 2099 in seconds since 2000-01-01 00:00:00
+#define ISL1208_EPOCH_INVALID 0xFFFFFFFFUL  //returned for a snapshot with a value out of range
+
+//a snapshot of the date and time in 24 hour format. the year is 0 to 99
+//for 2000 to 2099, same as the RTC register. the day of the week is
+//0 = Sunday to 6 = Saturday.
+
+struct ISL1208_DateTime {
+  byte year, month, date, hour, minute, second, day;
+};
+
+//========================================================================//
+//calendar functions for the years 2000 to 2099. all the functions are
+//static and do not use the RTC.
+
+class ISL1208_Calendar {
+  public:
+    static bool isLeapYear (byte); //returns true if the year (0 to 99) is a leap year
+    static byte daysInMonth (byte, byte); //returns the number of days in a month of a year
+    static bool isValid (const ISL1208_DateTime&); //checks the ranges of all the values including the days in month
+    static uint16_t daysSince2000 (byte, byte, byte); //returns the number of days from 2000-01-01 to a date, or 0xFFFF for an invalid month
+    static byte dayOfWeek (byte, byte, byte); //returns the day of the week (0 = Sunday) of a date
+    static uint32_t toEpoch (const ISL1208_DateTime&); //converts a snapshot to seconds since 2000-01-01 00:00:00. returns ISL1208_EPOCH_INVALID if it is invalid
+    static bool fromEpoch (uint32_t, ISL1208_DateTime&); //converts seconds since 2000-01-01 00:00:00 to a snapshot. returns false after 2099
+    static bool addSeconds (ISL1208_DateTime&, int32_t); //adds a positive or negative duration. returns false if the result is out of range
+    static int32_t diffSeconds (const ISL1208_DateTime&, const ISL1208_DateTime&); //returns the first snapshot minus the second in seconds
+    static int8_t compare (const ISL1208_DateTime&, const ISL1208_DateTime&); //returns -1, 0 or 1 if the first snapshot is earlier, equal or later
+};
+
+//========================================================================//
+
+#endif //end _ISL1208_CALENDAR_H_
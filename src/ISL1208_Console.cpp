@@ -0,0 +1,378 @@
+
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  ISL1208 is an RTC from Intersil. This is an Arduino compatible
+//  library for ISL1208.
+//
+//  Filename: ISL1208_Console.cpp
+//  Description: Part of ISL1208 RTC library.
+//  Library version: 1.4.7
+//  Author: Vishnu Mohanan (@vishnumaiea)
+//  Source: https://github.com/vishnumaiea/ISL1208-RTC-Library
+//  Initial release: IST 11:49:42 AM, 27-05-2018, Sunday
+//  License: MIT
+//
+//  File last modified: +05:30 09:58:40 PM 19-10-2026, Monday
+//
+//========================================================================//
+
+#include "ISL1208_Console.h"
+
+//========================================================================//
+//list of supported commands. add new commands here.
+
+const ISL1208_Command ISL1208_Console::commandTable[] = {
+  {"printtime", printTimeCommand},
+  {"printalarmtime", printAlarmTimeCommand},
+  {"settime", setTimeCommand},
+  {"setalarm", setAlarmCommand},
+  {"printdate", printDateCommand},
+  {"printdateday", printDateDayCommand},
+  {"printday", printDayCommand},
+  {"printtimedate", printTimeDateCommand},
+  {"printtimedateday", printTimeDateDayCommand},
+  {"printstatus", printStatusCommand},
+  {"printepoch", printEpochCommand},
+  {"setepoch", setEpochCommand},
+  {NULL, NULL} //end of table
+};
+
+//========================================================================//
+//constructor. the RTC and stream must be initialized separately.
+
+ISL1208_Console::ISL1208_Console (ISL1208_RTC &rtcObject, Stream &streamObject) : rtc(rtcObject), stream(streamObject) {
+  lineLength = 0;
+  isOverflow = false;
+  tokenCount = 0;
+}
+
+//========================================================================//
+//call this from the loop. it only reads the bytes that are already
+//available, so it never waits for the rest of a line. CR is ignored,
+//so both NL and CR+NL line endings work.
+
+bool ISL1208_Console::poll() {
+  while (stream.available() > 0) {
+    int inputChar = stream.read();
+
+    if (inputChar < 0) {
+      break;
+    }
+
+    if (inputChar == '\r') {
+      continue;
+    }
+
+    if (inputChar == '\n') { //end of line
+      if (isOverflow) {
+        stream.println(F("Input too long."));
+        lineLength = 0;
+        isOverflow = false;
+        continue;
+      }
+
+      lineBuffer[lineLength] = '\0';
+      lineLength = 0;
+      tokenize();
+
+      if (tokenCount > 0) {
+        dispatch();
+        return true;
+      }
+
+      continue;
+    }
+
+    if (lineLength < (ISL1208_CONSOLE_BUFFER_SIZE - 1)) {
+      lineBuffer[lineLength++] = char(inputChar);
+    }
+    else {
+      isOverflow = true;
+    }
+  }
+
+  return false;
+}
+
+//========================================================================//
+
+byte ISL1208_Console::getParamCount() {
+  return (tokenCount > 0) ? (tokenCount - 1) : 0;
+}
+
+//========================================================================//
+
+const char* ISL1208_Console::getParam (byte n) {
+  if ((n + 1) < tokenCount) {
+    return tokens[n + 1];
+  }
+
+  return "";
+}
+
+//========================================================================//
+//splits the line at whitespaces by replacing them with null characters.
+//extra tokens are ignored.
+
+void ISL1208_Console::tokenize() {
+  char *charPointer = lineBuffer;
+  tokenCount = 0;
+
+  while ((*charPointer != '\0') && (tokenCount < ISL1208_CONSOLE_MAX_TOKENS)) {
+    while ((*charPointer == ' ') || (*charPointer == '\t')) { //skip leading whitespace
+      charPointer++;
+    }
+
+    if (*charPointer == '\0') {
+      break;
+    }
+
+    tokens[tokenCount++] = charPointer;
+
+    while ((*charPointer != '\0') && (*charPointer != ' ') && (*charPointer != '\t')) {
+      charPointer++;
+    }
+
+    if (*charPointer != '\0') {
+      *charPointer++ = '\0'; //terminate the token
+    }
+  }
+}
+
+//========================================================================//
+
+void ISL1208_Console::dispatch() {
+  for (const ISL1208_Command *command = commandTable; command->name != NULL; command++) {
+    if (strcmp(tokens[0], command->name) == 0) {
+      command->handler(*this);
+      return;
+    }
+  }
+
+  stream.print(F("Unknown command - "));
+  stream.println(tokens[0]);
+}
+
+//========================================================================//
+
+bool ISL1208_Console::fetchOrReport() {
+  if (rtc.fetchTime()) {
+    return true;
+  }
+
+  stream.print(F("Error: Could not read RTC. Error code "));
+  stream.println(rtc.getLastError());
+  return false;
+}
+
+//========================================================================//
+//prints the time from the saved values (hh:mm:ss pp).
+
+void ISL1208_Console::printTime() {
+  stream.print(rtc.hourValue);
+  stream.print(':');
+  stream.print(rtc.minuteValue);
+  stream.print(':');
+  stream.print(rtc.secondValue);
+
+  if (!rtc.is24HourMode()) {
+    stream.print((rtc.periodValue == 0) ? F(" AM") : F(" PM"));
+  }
+}
+
+//========================================================================//
+//prints the date from the saved values (DD-MM-YYYY).
+
+void ISL1208_Console::printDate() {
+  stream.print(rtc.dateValue);
+  stream.print('-');
+  stream.print(rtc.monthValue);
+  stream.print('-');
+  stream.print(rtc.yearValue + 2000);
+}
+
+//========================================================================//
+
+void ISL1208_Console::printDay (byte day) {
+  stream.print(ISL1208_RTC::getDayName(rtc.startOfTheWeek + day));
+}
+
+//========================================================================//
+
+void ISL1208_Console::printTimeCommand (ISL1208_Console &console) {
+  if (console.fetchOrReport()) {
+    console.printTime();
+    console.stream.println();
+  }
+}
+
+//========================================================================//
+
+void ISL1208_Console::printAlarmTimeCommand (ISL1208_Console &console) {
+  if (console.fetchOrReport()) {
+    ISL1208_RTC &rtc = console.rtc;
+    Stream &stream = console.stream;
+
+    stream.print(rtc.hourValueAlarm);
+    stream.print(':');
+    stream.print(rtc.minuteValueAlarm);
+    stream.print(':');
+    stream.print(rtc.secondValueAlarm);
+
+    if (rtc.is24HourMode()) {
+      stream.print(F(", "));
+    }
+    else {
+      stream.print((rtc.periodValueAlarm == 0) ? F(" AM, ") : F(" PM, "));
+    }
+    stream.print(rtc.dateValueAlarm);
+    stream.print('-');
+    stream.print(rtc.monthValueAlarm);
+    stream.print(F(", "));
+    console.printDay(rtc.dayValueAlarm);
+    stream.println();
+  }
+}
+
+//========================================================================//
+//first param should be the time string (TYYMMDDhhmmsspd#)
+
+void ISL1208_Console::setTimeCommand (ISL1208_Console &console) {
+  if (console.rtc.setTime(console.getParam(0))) {
+    console.stream.println(F("Time updated."));
+  }
+  else {
+    console.stream.println(F("Time update failed."));
+  }
+}
+
+//========================================================================//
+//first param should be the alarm string (AMMDDhhmmsspd#)
+
+void ISL1208_Console::setAlarmCommand (ISL1208_Console &console) {
+  if (console.rtc.setAlarmTime(console.getParam(0))) {
+    console.stream.println(F("Alarm updated."));
+  }
+  else {
+    console.stream.println(F("Alarm update failed."));
+  }
+}
+
+//========================================================================//
+
+void ISL1208_Console::printDateCommand (ISL1208_Console &console) {
+  if (console.fetchOrReport()) {
+    console.printDate();
+    console.stream.println();
+  }
+}
+
+//========================================================================//
+
+void ISL1208_Console::printDateDayCommand (ISL1208_Console &console) {
+  if (console.fetchOrReport()) {
+    console.printDate();
+    console.stream.print(F(", "));
+    console.printDay(console.rtc.dayValue);
+    console.stream.println();
+  }
+}
+
+//========================================================================//
+
+void ISL1208_Console::printDayCommand (ISL1208_Console &console) {
+  if (console.fetchOrReport()) {
+    console.printDay(console.rtc.dayValue);
+    console.stream.println();
+  }
+}
+
+//========================================================================//
+
+void ISL1208_Console::printTimeDateCommand (ISL1208_Console &console) {
+  if (console.fetchOrReport()) {
+    console.printTime();
+    console.stream.print(F(", "));
+    console.printDate();
+    console.stream.println();
+  }
+}
+
+//========================================================================//
+
+void ISL1208_Console::printTimeDateDayCommand (ISL1208_Console &console) {
+  if (console.fetchOrReport()) {
+    console.printTime();
+    console.stream.print(F(", "));
+    console.printDate();
+    console.stream.print(F(", "));
+    console.printDay(console.rtc.dayValue);
+    console.stream.println();
+  }
+}
+
+//========================================================================//
+//prints the status register along with the names of the set bits.
+
+void ISL1208_Console::printStatusCommand (ISL1208_Console &console) {
+  int statusValue = console.rtc.getStatus();
+  Stream &stream = console.stream;
+
+  if (statusValue < 0) {
+    stream.print(F("Error: Could not read RTC. Error code "));
+    stream.println(console.rtc.getLastError());
+    return;
+  }
+
+  stream.print(F("Status = 0x"));
+  stream.print(statusValue, HEX);
+
+  if (statusValue & ISL1208_SR_ARST) stream.print(F(" ARST"));
+  if (statusValue & ISL1208_SR_XTOSCB) stream.print(F(" XTOSCB"));
+  if (statusValue & ISL1208_SR_WRTC) stream.print(F(" WRTC"));
+  if (statusValue & ISL1208_SR_ALM) stream.print(F(" ALM"));
+  if (statusValue & ISL1208_SR_BAT) stream.print(F(" BAT"));
+  if (statusValue & ISL1208_SR_RTCF) stream.print(F(" RTCF"));
+
+  stream.println();
+}
+
+//========================================================================//
+//prints the time as UTC seconds since 2000-01-01 00:00:00
+
+void ISL1208_Console::printEpochCommand (ISL1208_Console &console) {
+  uint32_t epochTime;
+
+  if (!console.rtc.getEpoch(epochTime)) {
+    console.stream.print(F("Error: Could not read RTC. Error code "));
+    console.stream.println(console.rtc.getLastError());
+    return;
+  }
+
+  console.stream.println(epochTime);
+}
+
+//========================================================================//
+//first param should be the UTC seconds since 2000-01-01 00:00:00
+
+void ISL1208_Console::setEpochCommand (ISL1208_Console &console) {
+  const char *epochString = console.getParam(0);
+  char *endPointer;
+  uint32_t epochTime = strtoul(epochString, &endPointer, 10);
+
+  if ((*epochString == '\0') || (*endPointer != '\0') || (epochTime > ISL1208_EPOCH_MAX)) {
+    console.stream.println(F("Invalid epoch input."));
+    return;
+  }
+
+  if (console.rtc.setEpoch(epochTime)) {
+    console.stream.println(F("Time updated."));
+  }
+  else {
+    console.stream.println(F("Time update failed."));
+  }
+}
+
+//========================================================================//
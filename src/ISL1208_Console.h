@@ -0,0 +1,85 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  ISL1208 is an RTC from Intersil. This is an Arduino compatible
+//  library for ISL1208.
+//
+//  Filename: ISL1208_Console.h
+//  Description: Header file for the serial command console of ISL1208_RTC.
+//  Library version: 1.4.7
+//  Author: Vishnu Mohanan (@vishnumaiea)
+//  Source: https://github.com/vishnumaiea/ISL1208-RTC-Library
+//  Initial release: IST 11:49:42 AM, 27-05-2018, Sunday
+//  License: MIT
+//
+//  File last modified: +05:30 07:06:19 PM 19-10-2026, Monday
+//
+//========================================================================//
+
+#include "ISL1208_RTC.h"
+
+#ifndef _ISL1208_CONSOLE_H_
+#define _ISL1208_CONSOLE_H_
+
+//========================================================================//
+
+#define ISL1208_CONSOLE_BUFFER_SIZE   32  //max line length including the terminator
+#define ISL1208_CONSOLE_MAX_TOKENS    4   //command + 3 parameters
+
+class ISL1208_Console;
+
+typedef void (*ISL1208_CommandHandler) (ISL1208_Console&); //command function type
+
+struct ISL1208_Command {
+  const char *name; //command string as typed in the console
+  ISL1208_CommandHandler handler;
+};
+
+//========================================================================//
+//reads commands from a stream one byte at a time and runs them on the RTC.
+//a command is a line of whitespace separated tokens ending with NL.
+//no heap memory is used.
+
+class ISL1208_Console {
+  public:
+    ISL1208_Console (ISL1208_RTC&, Stream&); //constructor
+    bool poll(); //reads the available bytes and runs a command if a full line is received
+    byte getParamCount(); //returns the number of parameters after the command
+    const char* getParam (byte); //returns the nth parameter (0 to 2), or an empty string
+
+  private:
+    ISL1208_RTC &rtc;
+    Stream &stream;
+    char lineBuffer[ISL1208_CONSOLE_BUFFER_SIZE];
+    byte lineLength;
+    bool isOverflow; //set when the line is too long. the rest of the line is dropped
+    char *tokens[ISL1208_CONSOLE_MAX_TOKENS];
+    byte tokenCount;
+
+    static const ISL1208_Command commandTable[];
+
+    void tokenize(); //splits the line buffer in place
+    void dispatch(); //finds the command in the table and runs it
+    bool fetchOrReport(); //fetches the time and prints an error if it fails
+    void printTime();
+    void printDate();
+    void printDay (byte);
+
+    static void printTimeCommand (ISL1208_Console&);
+    static void printAlarmTimeCommand (ISL1208_Console&);
+    static void setTimeCommand (ISL1208_Console&);
+    static void setAlarmCommand (ISL1208_Console&);
+    static void printDateCommand (ISL1208_Console&);
+    static void printDateDayCommand (ISL1208_Console&);
+    static void printDayCommand (ISL1208_Console&);
+    static void printTimeDateCommand (ISL1208_Console&);
+    static void printTimeDateDayCommand (ISL1208_Console&);
+    static void printStatusCommand (ISL1208_Console&);
+    static void printEpochCommand (ISL1208_Console&);
+    static void setEpochCommand (ISL1208_Console&);
+};
+
+//========================================================================//
+
+#endif //end _ISL1208_CONSOLE_H_
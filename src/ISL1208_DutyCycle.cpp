@@ -0,0 +1,217 @@
+
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  ISL1208 is an RTC from Intersil. This is an Arduino compatible
+//  library for ISL1208.
+//
+//  Filename: ISL1208_DutyCycle.cpp
+//  Description: Part of ISL1208 RTC library.
+//  Library version: 1.4.7
+//  Author: Vishnu Mohanan (@vishnumaiea)
+//  Source: https://github.com/vishnumaiea/ISL1208-RTC-Library
+//  Initial release: IST 11:49:42 AM, 27-05-2018, Sunday
+//  License: MIT
+//
+//  File last modified: +05:30 10:16:27 PM 19-10-2026, Monday
+//
+//========================================================================//
+
+#include "ISL1208_DutyCycle.h"
+
+//========================================================================//
+//constructor. the awake time is counted from here until the first sleep.
+
+ISL1208_DutyCycle::ISL1208_DutyCycle (ISL1208_RTC &rtcObject) : rtc(rtcObject) {
+  wakeMillis = millis();
+  awakeTime = 0;
+  driverTime = 0;
+  wakeCount = 0;
+  isAwake = true;
+}
+
+//========================================================================//
+//reads the status register in a single byte read and finds why the MCU woke
+//up. if the alarm caused it, the ALM bit is cleared so that the IRQ pin is
+//released for the next alarm. BAT is kept since writing 1 doesn't set it.
+//flags that an earlier status read cleared with ARST set are included.
+
+byte ISL1208_DutyCycle::wake() {
+  ISL1208_RTC::BusCall busCall(rtc); //the read and the ALM clear
+  unsigned long startTime = micros();
+  byte statusValue;
+  byte wakeCause;
+
+  if (!isAwake) {
+    wakeMillis = millis();
+    isAwake = true;
+  }
+
+  wakeCount++;
+
+  bool isRead = rtc.readRegisters(ISL1208_SR, &statusValue, 1);
+
+  if (isRead) {
+    rtc.saveStatus(statusValue);
+    statusValue |= rtc.clearedStatus;
+    rtc.clearedStatus = 0;
+  }
+
+  if (!isRead) {
+    wakeCause = ISL1208_WAKE_ERROR;
+  }
+  else if (statusValue & ISL1208_SR_RTCF) {
+    wakeCause = ISL1208_WAKE_POWER_FAIL;
+  }
+  else if (statusValue & ISL1208_SR_ALM) {
+    wakeCause = ISL1208_WAKE_ALARM;
+    statusValue &= ~ISL1208_SR_ALM;
+    rtc.writeRegisters(ISL1208_SR, &statusValue, 1);
+  }
+  else if (statusValue & ISL1208_SR_BAT) {
+    wakeCause = ISL1208_WAKE_BATTERY;
+  }
+  else {
+    wakeCause = ISL1208_WAKE_OTHER;
+  }
+
+  driverTime += micros() - startTime;
+  return wakeCause;
+}
+
+//========================================================================//
+//the time is local if the RTC has a time zone, and must be later than the
+//RTC time. it is converted to UTC here, so the alarm uses the DST offset in
+//effect at the wake up time.
+
+bool ISL1208_DutyCycle::sleepUntil (const ISL1208_DateTime &wakeTime) {
+  uint32_t wakeEpoch = ISL1208_Calendar::toEpoch(wakeTime);
+
+  if ((wakeEpoch != ISL1208_EPOCH_INVALID) && (rtc.timeZone != NULL)) { //the RTC keeps UTC
+    wakeEpoch = rtc.timeZone->toUtc(wakeEpoch);
+  }
+
+  if (wakeEpoch == ISL1208_EPOCH_INVALID) {
+    rtc.lastError = ISL1208_ERROR_INVALID_DATA;
+    return false;
+  }
+
+  return sleepUntil(wakeEpoch);
+}
+
+//========================================================================//
+//sets the alarm to the given UTC time with the seconds, minutes, hours, date
+//and month matched, and enables the alarm interrupt in single event mode
+//with the frequency output off, so the IRQ pin goes low on the alarm. the
+//status register and all the written registers are then read back in one
+//transfer and compared. the time is read last, so an alarm that matched
+//while it was being set is caught either by ALM or by the time check.
+//returns false if ALM is already set or the wake up time is not later than
+//the RTC time, since the IRQ pin would never go low or is already low. the
+//alarm registers have no year, so it also returns false if the alarm
+//matches before the wake up time, such as a year or more ahead.
+
+bool ISL1208_DutyCycle::sleepUntil (uint32_t wakeTime) {
+  ISL1208_RTC::BusCall busCall(rtc); //one timeout for all the transfers
+  unsigned long startTime = micros();
+  ISL1208_DateTime alarmTime;
+  ISL1208_DateTime currentTime;
+  byte interruptValue;
+  byte alarmData[6];
+  byte readData[11]; //status register to alarm day of the week register
+  bool isVerified = false;
+
+  if (!ISL1208_Calendar::fromEpoch(wakeTime, alarmTime)) {
+    rtc.lastError = ISL1208_ERROR_INVALID_DATA;
+    driverTime += micros() - startTime;
+    return false;
+  }
+
+  alarmTime.day = 0; //the day of the week is not matched
+  rtc.encodeAlarm(alarmTime, alarmData);
+
+  //the alarm is written before it is enabled, so the old alarm can't fire
+  if (rtc.readRegisters(ISL1208_INT, &interruptValue, 1) &&
+    rtc.writeRegisters(ISL1208_SCA, alarmData, 6)) {
+      interruptValue = (interruptValue & (ISL1208_INT_LPMODE | ISL1208_INT_FOBATB)) | ISL1208_INT_ALME;
+
+      if (rtc.writeRegisters(ISL1208_INT, &interruptValue, 1) &&
+        rtc.readRegisters(ISL1208_SR, readData, 11)) {
+          rtc.saveStatus(readData[0]);
+          isVerified = ((readData[0] & ISL1208_SR_ALM) == 0) && (readData[1] == interruptValue) &&
+            (memcmp(readData + 5, alarmData, 6) == 0);
+      }
+  }
+
+  if (isVerified && rtc.readTime(currentTime)) {
+    ISL1208_DateTime matchTime = alarmTime; //the alarm fires at its next match, whatever the year
+
+    isVerified = (wakeTime > ISL1208_Calendar::toEpoch(currentTime)) && rtc.setAlarmYear(matchTime, currentTime) &&
+      (ISL1208_Calendar::toEpoch(matchTime) == wakeTime);
+
+    if (!isVerified) {
+      rtc.lastError = ISL1208_ERROR_INVALID_DATA; //the wake up time has passed or the alarm matches earlier
+    }
+  }
+  else {
+    isVerified = false;
+  }
+
+  if (isVerified && isAwake) {
+    awakeTime += millis() - wakeMillis;
+    isAwake = false;
+  }
+
+  driverTime += micros() - startTime;
+  return isVerified;
+}
+
+//========================================================================//
+//the time is read from the RTC, so the alarm is exact even if the MCU clock
+//is not. the duration is added in UTC, so it is exact across DST changes.
+
+bool ISL1208_DutyCycle::sleepFor (uint32_t duration) {
+  ISL1208_RTC::BusCall busCall(rtc); //includes the transfers of sleepUntil()
+  unsigned long startTime = micros();
+  uint32_t currentTime;
+  bool isTimeRead = rtc.getEpoch(currentTime);
+
+  driverTime += micros() - startTime;
+
+  if (!isTimeRead) {
+    return false;
+  }
+
+  if (duration > (ISL1208_EPOCH_MAX - currentTime)) {
+    rtc.lastError = ISL1208_ERROR_INVALID_DATA;
+    return false;
+  }
+
+  return sleepUntil(currentTime + duration);
+}
+
+//========================================================================//
+//includes the time until the current sleepUntil() if still awake.
+
+unsigned long ISL1208_DutyCycle::getAwakeTime() {
+  if (isAwake) {
+    return awakeTime + (millis() - wakeMillis);
+  }
+
+  return awakeTime;
+}
+
+//========================================================================//
+
+unsigned long ISL1208_DutyCycle::getDriverTime() {
+  return driverTime;
+}
+
+//========================================================================//
+
+unsigned long ISL1208_DutyCycle::getWakeCount() {
+  return wakeCount;
+}
+
+//========================================================================//
@@ -0,0 +1,63 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  ISL1208 is an RTC from Intersil. This is an Arduino compatible
+//  library for ISL1208.
+//
+//  Filename: ISL1208_DutyCycle.h
+//  Description: Header file for the alarm based sleep and wake helper of ISL1208_RTC.
+//  Library version: 1.4.7
+//  Author: Vishnu Mohanan (@vishnumaiea)
+//  Source: https://github.com/vishnumaiea/ISL1208-RTC-Library
+//  Initial release: IST 11:49:42 AM, 27-05-2018, Sunday
+//  License: MIT
+//
+//  File last modified: +05:30 08:02:36 PM 19-10-2026, Monday
+//
+//========================================================================//
+
+#include "ISL1208_RTC.h"
+
+#ifndef _ISL1208_DUTYCYCLE_H_
+#define _ISL1208_DUTYCYCLE_H_
+
+//========================================================================//
+
+//wake up causes returned by wake()
+
+#define ISL1208_WAKE_OTHER        0  //no RTC flag was set. the wake up came from somewhere else
+#define ISL1208_WAKE_ALARM        1  //alarm matched (ALM)
+#define ISL1208_WAKE_POWER_FAIL   2  //total power failure (RTCF). the time is not valid
+#define ISL1208_WAKE_BATTERY      3  //the RTC ran on battery (BAT)
+#define ISL1208_WAKE_ERROR        4  //the status register couldn't be read
+
+//========================================================================//
+//programs the RTC alarm to wake the MCU through the IRQ pin, so the MCU can
+//sleep until the work is due instead of polling the time. call wake() first
+//thing after waking up and sleepUntil() just before going to sleep.
+//the time spent awake and in the driver is measured.
+
+class ISL1208_DutyCycle {
+  public:
+    ISL1208_DutyCycle (ISL1208_RTC&); //constructor
+    byte wake(); //reads the status register once and returns the wake up cause
+    bool sleepUntil (const ISL1208_DateTime&); //programs and verifies the alarm. returns false if the MCU should not sleep
+    bool sleepUntil (uint32_t); //same as above with UTC seconds since 2000-01-01 00:00:00
+    bool sleepFor (uint32_t); //reads the time and sets the alarm a number of seconds later
+    unsigned long getAwakeTime(); //returns the total time spent awake in milliseconds
+    unsigned long getDriverTime(); //returns the total time spent in this driver in microseconds
+    unsigned long getWakeCount(); //returns the number of times wake() was called
+
+  private:
+    ISL1208_RTC &rtc;
+    unsigned long wakeMillis; //millis() at the last wake up
+    unsigned long awakeTime;
+    unsigned long driverTime;
+    unsigned long wakeCount;
+    bool isAwake;
+};
+
+//========================================================================//
+
+#endif //end _ISL1208_DUTYCYCLE_H_
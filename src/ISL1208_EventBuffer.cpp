@@ -0,0 +1,169 @@
+
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  ISL1208 is an RTC from Intersil. This is an Arduino compatible
+//  library for ISL1208.
+//
+//  Filename: ISL1208_EventBuffer.cpp
+//  Description: Part of ISL1208 RTC library.
+//  Library version: 1.4.7
+//  Author: Vishnu Mohanan (@vishnumaiea)
+//  Source: https://github.com/vishnumaiea/ISL1208-RTC-Library
+//  Initial release: IST 11:49:42 AM, 27-05-2018, Sunday
+//  License: MIT
+//
+//  File last modified: +05:30 08:21:14 PM 19-10-2026, Monday
+//
+//========================================================================//
+
+#include "ISL1208_EventBuffer.h"
+
+//========================================================================//
+//constructor. the storage array must have at least the given number of
+//events and must stay valid for the life of the buffer.
+
+ISL1208_EventBuffer::ISL1208_EventBuffer (ISL1208_RTC &rtcObject, ISL1208_Event *storage, uint16_t size) : rtc(rtcObject) {
+  events = storage;
+  capacity = size;
+  head = 0;
+  count = 0;
+  droppedCount = 0;
+  syncEpoch = 0;
+  syncMillis = 0;
+  isSynced = false;
+}
+
+//========================================================================//
+//reads the RTC time and saves it with the current millis() value.
+//the cached clock keeps the last synced time if the read fails or the RTC
+//holds an invalid time.
+
+bool ISL1208_EventBuffer::sync() {
+  uint32_t epochTime;
+
+  if (!rtc.getEpoch(epochTime)) {
+    return false;
+  }
+
+  syncEpoch = epochTime;
+  syncMillis = millis();
+  isSynced = true;
+  return true;
+}
+
+//========================================================================//
+//returns the time from the last sync plus the seconds elapsed since then.
+//the RTC is never read here, so call sync() first. returns 0 until a sync
+//has succeeded.
+
+uint32_t ISL1208_EventBuffer::now() {
+  if (!isSynced) {
+    return 0;
+  }
+
+  return syncEpoch + ((millis() - syncMillis) / 1000);
+}
+
+//========================================================================//
+
+bool ISL1208_EventBuffer::isClockSynced() {
+  return isSynced;
+}
+
+//========================================================================//
+//events can't be stamped until a sync has succeeded, because there is no
+//time to stamp them with. such events are not counted as dropped.
+
+bool ISL1208_EventBuffer::stamp (uint16_t code) {
+  if (!isSynced) {
+    return false;
+  }
+
+  if (count >= capacity) {
+    droppedCount++;
+    return false;
+  }
+
+  uint16_t tail = (head + count) % capacity;
+  events[tail].timestamp = now();
+  events[tail].code = code;
+  count++;
+  return true;
+}
+
+//========================================================================//
+
+bool ISL1208_EventBuffer::pop (ISL1208_Event &event) {
+  if (count == 0) {
+    return false;
+  }
+
+  event = events[head];
+  head = (head + 1) % capacity;
+  count--;
+  return true;
+}
+
+//========================================================================//
+
+uint16_t ISL1208_EventBuffer::available() {
+  return count;
+}
+
+//========================================================================//
+
+uint16_t ISL1208_EventBuffer::getDroppedCount() {
+  return droppedCount;
+}
+
+//========================================================================//
+
+void ISL1208_EventBuffer::clear() {
+  head = 0;
+  count = 0;
+  droppedCount = 0;
+}
+
+//========================================================================//
+//moves as many events as fit to the byte array. each event takes
+//ISL1208_EVENT_SIZE bytes in little endian order, the time first and then
+//the code. the array can be written to flash or serial directly.
+
+uint16_t ISL1208_EventBuffer::encode (byte *buffer, uint16_t length) {
+  uint16_t byteCount = 0;
+  ISL1208_Event event;
+
+  while (((length - byteCount) >= ISL1208_EVENT_SIZE) && pop(event)) {
+    buffer[byteCount++] = byte(event.timestamp);
+    buffer[byteCount++] = byte(event.timestamp >> 8);
+    buffer[byteCount++] = byte(event.timestamp >> 16);
+    buffer[byteCount++] = byte(event.timestamp >> 24);
+    buffer[byteCount++] = byte(event.code);
+    buffer[byteCount++] = byte(event.code >> 8);
+  }
+
+  return byteCount;
+}
+
+//========================================================================//
+//converts an array written by encode() back to events. incomplete events at
+//the end are ignored. returns the number of events decoded.
+
+uint16_t ISL1208_EventBuffer::decode (const byte *buffer, uint16_t length, ISL1208_Event *output, uint16_t maxEvents) {
+  uint16_t eventCount = 0;
+
+  while (((length / ISL1208_EVENT_SIZE) > eventCount) && (eventCount < maxEvents)) {
+    const byte *eventData = buffer + (eventCount * ISL1208_EVENT_SIZE);
+
+    output[eventCount].timestamp = (uint32_t) eventData[0] | ((uint32_t) eventData[1] << 8) |
+      ((uint32_t) eventData[2] << 16) | ((uint32_t) eventData[3] << 24);
+    output[eventCount].code = (uint16_t) eventData[4] | ((uint16_t) eventData[5] << 8);
+    eventCount++;
+  }
+
+  return eventCount;
+}
+
+//========================================================================//
@@ -0,0 +1,73 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  ISL1208 is an RTC from Intersil. This is an Arduino compatible
+//  library for ISL1208.
+//
+//  Filename: ISL1208_EventBuffer.h
+//  Description: Header file for the event time stamping buffer of ISL1208_RTC.
+//  Library version: 1.4.7
+//  Author: Vishnu Mohanan (@vishnumaiea)
+//  Source: https://github.com/vishnumaiea/ISL1208-RTC-Library
+//  Initial release: IST 11:49:42 AM, 27-05-2018, Sunday
+//  License: MIT
+//
+//  File last modified: +05:30 08:21:14 PM 19-10-2026, Monday
+//
+//========================================================================//
+
+#include "ISL1208_RTC.h"
+
+#ifndef _ISL1208_EVENTBUFFER_H_
+#define _ISL1208_EVENTBUFFER_H_
+
+//========================================================================//
+
+#define ISL1208_EVENT_SIZE    6  //size of an encoded event in bytes (4 bytes time + 2 bytes code)
+
+//an event is a user defined code and the time it happened. the time is in
+//UTC seconds since 2000-01-01 00:00:00, the same as ISL1208_RTC::getEpoch(),
+//so it doesn't jump at DST changes.
+
+struct ISL1208_Event {
+  uint32_t timestamp;
+  uint16_t code;
+};
+
+//========================================================================//
+//a fixed size ring buffer of time stamped events. events are stamped from a
+//clock cached in RAM, so stamping never uses the I2C bus. the cached clock
+//runs on millis(). sync() must succeed once before events can be stamped,
+//and should be called from time to time after that.
+//the storage array is provided by the caller.
+
+class ISL1208_EventBuffer {
+  public:
+    ISL1208_EventBuffer (ISL1208_RTC&, ISL1208_Event*, uint16_t); //constructor
+    bool sync(); //reads the RTC once and restarts the cached clock
+    uint32_t now(); //returns the cached time without reading the RTC. returns 0 before the first sync
+    bool isClockSynced(); //returns true once a sync has succeeded
+    bool stamp (uint16_t); //saves an event with the cached time. returns false if the buffer is full or not synced
+    bool pop (ISL1208_Event&); //removes the oldest event
+    uint16_t available(); //returns the number of saved events
+    uint16_t getDroppedCount(); //returns the number of events lost because the buffer was full
+    void clear(); //removes all the events
+    uint16_t encode (byte*, uint16_t); //moves the oldest events to a byte array. returns the number of bytes written
+    static uint16_t decode (const byte*, uint16_t, ISL1208_Event*, uint16_t); //converts a byte array back to events
+
+  private:
+    ISL1208_RTC &rtc;
+    ISL1208_Event *events;
+    uint16_t capacity;
+    uint16_t head; //position of the oldest event
+    uint16_t count;
+    uint16_t droppedCount;
+    uint32_t syncEpoch; //RTC time at the last sync
+    unsigned long syncMillis; //millis() at the last sync
+    bool isSynced;
+};
+
+//========================================================================//
+
+#endif //end _ISL1208_EVENTBUFFER_H_
@@ -14,16 +14,39 @@
 //  Initial release: IST 11:49:42 AM, 27-05-2018, Sunday
 //  License: MIT
 //
-//  File last modified: +05:30 21:52:51 PM 09-12-2021, Thursday
+//  File last modified: +05:30 10:07:52 PM 19-10-2026, Monday
 //
 //========================================================================//
 
 #include "ISL1208_RTC.h"
 
+const char *const ISL1208_RTC::dayNamesArray[7] = {"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"};
+
 //========================================================================//
 //constructor
 
 ISL1208_RTC::ISL1208_RTC () {
+  wireBus = &Wire;
+  lastError = ISL1208_ERROR_NONE;
+  busTimeout = ISL1208_BUS_TIMEOUT;
+  busRetries = ISL1208_BUS_RETRIES;
+  sdaPin = -1; //bus recovery is disabled until the pins are set
+  sclPin = -1;
+  lastLatency = 0;
+  maxLatency = 0;
+  callStartTime = 0;
+  callDepth = 0;
+  timeZone = NULL;
+  isMilMode = false;
+  clearedStatus = 0;
+}
+
+//========================================================================//
+//the bus must be started with begin() before the RTC is used, the same as
+//Wire.
+
+ISL1208_RTC::ISL1208_RTC (TwoWire &bus) : ISL1208_RTC() {
+  wireBus = &bus;
 }
 
 //========================================================================//
@@ -50,22 +73,34 @@ void ISL1208_RTC::begin() {
   startOfTheWeek = 0;
   tempByte = 0;
 
+  #ifdef WIRE_HAS_TIMEOUT
+    wireBus->setWireTimeout((uint32_t) busTimeout * 1000, true); //let the Wire library abort a hung transfer
+  #endif
+
   //set the WRTC (Write RTC Enable Bit) bit to 1 to enable the RTC.
   //only then the RTC start counting.
-  Wire.beginTransmission(ISL1208_ADDRESS);
-  Wire.write(ISL1208_SR); //status register
-  Wire.write(0x10); //enable WRTC 
-  Wire.endTransmission();
+  tempByte = 0x10; //enable WRTC
+  writeRegisters(ISL1208_SR, &tempByte, 1); //status register
+
+  //the RTC keeps the hour format, so the mode is taken from the MIL bit of
+  //the hour register. the current mode is kept if the read fails.
+  byte hourData;
+
+  if (readRegisters(ISL1208_HR, &hourData, 1)) {
+    isMilMode = (hourData & B10000000) != 0;
+  }
 }
 
 //========================================================================//
-//determines if RTC is available on the bus.
+//determines if RTC is available on the bus. the interrupt register is read
+//with the same retries and bus recovery as the other operations, and the
+//time is counted in the latency. the status register is not used, because
+//reading it clears ALM and BAT when ARST is set.
 
 bool ISL1208_RTC::isRtcActive() {
-  Wire.beginTransmission(ISL1208_ADDRESS); //send the address
-  byte error = Wire.endTransmission(); //read ACK
+  byte interruptValue;
 
-  if (error == 0) { //if RTC is available
+  if (readRegisters(ISL1208_INT, &interruptValue, 1)) { //if RTC is available
     #ifdef ISL1208_RTC_DEBUG
       // Serial.println(F("RTC found on the bus."));
     #endif
@@ -79,6 +114,269 @@ bool ISL1208_RTC::isRtcActive() {
   return false;
 }
 
+//========================================================================//
+//sets the maximum time a call can take, including all the retries. calls
+//that use the bus more than once, such as fetchTime() or set24HourMode(),
+//share one timeout. no transfer is started after it expires, so the worst
+//case latency of any RTC call is this timeout plus the duration of one
+//transfer and one bus recovery.
+
+void ISL1208_RTC::setBusTimeout (uint16_t timeout) {
+  busTimeout = timeout;
+
+  #ifdef WIRE_HAS_TIMEOUT
+    wireBus->setWireTimeout((uint32_t) busTimeout * 1000, true);
+  #endif
+}
+
+//========================================================================//
+//sets how many times a failed transfer is repeated. 0 disables retries.
+
+void ISL1208_RTC::setBusRetries (byte retries) {
+  busRetries = retries;
+}
+
+//========================================================================//
+//sets the SDA and SCL pins used for bus recovery. recovery is only done
+//when the pins are known.
+
+void ISL1208_RTC::setBusPins (int sda, int scl) {
+  sdaPin = sda;
+  sclPin = scl;
+}
+
+//========================================================================//
+//a slave can hold SDA low if a transfer was interrupted in the middle of a
+//byte. clocking SCL up to 9 times lets it finish the byte and release SDA.
+//a STOP condition is then sent and the Wire library is restarted. the I2C
+//peripheral is stopped first, because it owns the pins while it is enabled
+//(TWEN on AVR). if you are using custom I2C pins, you might need to call
+//Wire.begin() again with your pins after this.
+
+bool ISL1208_RTC::recoverBus() {
+  if ((sdaPin < 0) || (sclPin < 0)) {
+    return false;
+  }
+
+  #ifdef ISL1208_RTC_DEBUG
+    Serial.println(F("Recovering I2C bus.."));
+  #endif
+
+  wireBus->end(); //release the pins
+
+  pinMode(sdaPin, INPUT_PULLUP); //release SDA
+  pinMode(sclPin, INPUT_PULLUP); //release SCL
+  delayMicroseconds(5);
+
+  for (byte i = 0; (i < 9) && (digitalRead(sdaPin) == LOW); i++) {
+    pinMode(sclPin, OUTPUT); //pull SCL low
+    digitalWrite(sclPin, LOW);
+    delayMicroseconds(5);
+    pinMode(sclPin, INPUT_PULLUP); //release SCL
+    delayMicroseconds(5);
+  }
+
+  //STOP condition is SDA going high while SCL is high
+  pinMode(sdaPin, OUTPUT);
+  digitalWrite(sdaPin, LOW);
+  delayMicroseconds(5);
+  pinMode(sdaPin, INPUT_PULLUP);
+  delayMicroseconds(5);
+
+  bool isReleased = (digitalRead(sdaPin) == HIGH) && (digitalRead(sclPin) == HIGH);
+
+  wireBus->begin(); //restart the I2C peripheral
+
+  #ifdef WIRE_HAS_TIMEOUT
+    wireBus->setWireTimeout((uint32_t) busTimeout * 1000, true);
+  #endif
+
+  return isReleased;
+}
+
+//========================================================================//
+//returns one of the ISL1208_ERROR_* codes for the last bus operation.
+
+byte ISL1208_RTC::getLastError() {
+  return lastError;
+}
+
+//========================================================================//
+//returns the time taken by the last call that used the bus in microseconds.
+//for fetchTime() this is both the time and the alarm read.
+
+unsigned long ISL1208_RTC::getLastLatency() {
+  return lastLatency;
+}
+
+//========================================================================//
+//returns the longest time taken by a call that used the bus in microseconds.
+
+unsigned long ISL1208_RTC::getMaxLatency() {
+  return maxLatency;
+}
+
+//========================================================================//
+//the first BusCall of a call saves the start time, and the last one to end
+//records the latency. functions that use the bus more than once create one
+//around all of their transfers.
+
+ISL1208_RTC::BusCall::BusCall (ISL1208_RTC &callRtc) : rtc(callRtc) {
+  if (rtc.callDepth++ == 0) {
+    rtc.callStartTime = micros();
+  }
+}
+
+ISL1208_RTC::BusCall::~BusCall() {
+  if (--rtc.callDepth == 0) {
+    rtc.recordLatency(rtc.callStartTime);
+  }
+}
+
+//========================================================================//
+//writes a number of bytes starting from a register address. the transfer is
+//retried until it succeeds, the retries are used up or the timeout of the
+//call expires. a later transfer of the same call is not started at all once
+//the timeout has expired.
+
+bool ISL1208_RTC::writeRegisters (byte startAddress, const byte *data, byte length) {
+  BusCall busCall(*this);
+  byte attempt = 0;
+
+  if ((callDepth > 1) && isCallExpired()) {
+    lastError = ISL1208_ERROR_TIMEOUT;
+    return false;
+  }
+
+  while ((lastError = writeOnce(startAddress, data, length)) != ISL1208_ERROR_NONE) {
+    if (!retryTransfer(attempt++)) break;
+  }
+
+  return (lastError == ISL1208_ERROR_NONE);
+}
+
+//========================================================================//
+//reads a number of bytes starting from a register address. the output buffer
+//is only valid if the function returns true.
+
+bool ISL1208_RTC::readRegisters (byte startAddress, byte *data, byte length) {
+  BusCall busCall(*this);
+  byte attempt = 0;
+
+  if ((callDepth > 1) && isCallExpired()) {
+    lastError = ISL1208_ERROR_TIMEOUT;
+    return false;
+  }
+
+  while ((lastError = readOnce(startAddress, data, length)) != ISL1208_ERROR_NONE) {
+    if (!retryTransfer(attempt++)) break;
+  }
+
+  return (lastError == ISL1208_ERROR_NONE);
+}
+
+//========================================================================//
+
+byte ISL1208_RTC::writeOnce (byte startAddress, const byte *data, byte length) {
+  wireBus->beginTransmission(ISL1208_ADDRESS); //send the I2C address of RTC
+  wireBus->write(startAddress);
+
+  for (byte i = 0; i < length; i++) {
+    wireBus->write(data[i]);
+  }
+
+  byte error = wireBus->endTransmission();
+  return (error > ISL1208_ERROR_TIMEOUT) ? ISL1208_ERROR_BUS : error;
+}
+
+//========================================================================//
+
+byte ISL1208_RTC::readOnce (byte startAddress, byte *data, byte length) {
+  wireBus->beginTransmission(ISL1208_ADDRESS); //send the I2C address of RTC
+  wireBus->write(startAddress); //set the register pointer
+
+  byte error = wireBus->endTransmission();
+
+  if (error != ISL1208_ERROR_NONE) {
+    return (error > ISL1208_ERROR_TIMEOUT) ? ISL1208_ERROR_BUS : error;
+  }
+
+  byte count = wireBus->requestFrom((uint8_t) ISL1208_ADDRESS, length);
+
+  if (count != length) { //discard the partial data
+    while (wireBus->available()) wireBus->read();
+    return ISL1208_ERROR_SHORT_READ;
+  }
+
+  for (byte i = 0; i < length; i++) {
+    int value = wireBus->read();
+
+    if (value < 0) { //data ran out
+      return ISL1208_ERROR_SHORT_READ;
+    }
+
+    data[i] = byte(value);
+  }
+
+  return ISL1208_ERROR_NONE;
+}
+
+//========================================================================//
+
+bool ISL1208_RTC::isCallExpired() {
+  return (micros() - callStartTime) >= ((unsigned long) busTimeout * 1000);
+}
+
+//========================================================================//
+//waits before the next attempt. the delay starts at ISL1208_BUS_BACKOFF and
+//is doubled every time, but never goes past the call timeout. the time is
+//counted in microseconds, so the last attempt starts before the timeout
+//expires. a timed out or failed bus is recovered before retrying.
+
+bool ISL1208_RTC::retryTransfer (byte attempt) {
+  unsigned long timeout = (unsigned long) busTimeout * 1000;
+  unsigned long elapsedTime = micros() - callStartTime;
+
+  if ((attempt >= busRetries) || (elapsedTime >= timeout)) {
+    #ifdef ISL1208_RTC_DEBUG
+      Serial.print(F("RTC bus error "));
+      Serial.println(lastError);
+    #endif
+
+    return false;
+  }
+
+  if ((lastError == ISL1208_ERROR_TIMEOUT) || (lastError == ISL1208_ERROR_BUS)) {
+    recoverBus();
+    elapsedTime = micros() - callStartTime;
+  }
+
+  unsigned long remainingTime = (elapsedTime < timeout) ? (timeout - elapsedTime) : 0;
+  unsigned long backoff = (unsigned long) ISL1208_BUS_BACKOFF * 1000;
+
+  for (byte i = 0; (i < attempt) && (backoff < remainingTime); i++) {
+    backoff <<= 1;
+  }
+
+  if (backoff > remainingTime) {
+    backoff = remainingTime;
+  }
+
+  delay(backoff / 1000);
+  delayMicroseconds(backoff % 1000);
+  return true;
+}
+
+//========================================================================//
+
+void ISL1208_RTC::recordLatency (unsigned long startTime) {
+  lastLatency = micros() - startTime;
+
+  if (lastLatency > maxLatency) {
+    maxLatency = lastLatency;
+  }
+}
+
 //========================================================================//
 //fetches time and alarm from serial monitor and update the RTC registers.
 //first save time values to the variables and then call this function.
@@ -88,63 +386,50 @@ bool ISL1208_RTC::isRtcActive() {
 //the local variables.
 
 bool ISL1208_RTC::updateTime() {
-  if (!isRtcActive()) { //check RTC
-    return false;
+  if (!isTimeValid()) {
+      #ifdef ISL1208_RTC_DEBUG
+        Serial.print(F("Invalid Date and Time"));
+      #endif
+
+      lastError = ISL1208_ERROR_INVALID_DATA;
+      return false;
   }
 
-  else {
-    if ((yearValue > 99) || (monthValue > 12) || (monthValue < 1) || (dateValue > 31) || (dateValue < 1) || (hourValue > 23) ||
-      (minuteValue > 59) || (secondValue > 59) || (dayValue > 6)) {
-        #ifdef ISL1208_RTC_DEBUG
-          Serial.print(F("Invalid Date and Time"));
-        #endif
+  //the day of the week is always calculated from the date
+  dayValue = calculateDay();
 
-        return false;
-    }
+  #ifdef ISL1208_RTC_DEBUG
+    Serial.println();
+    Serial.println(F("Updating time from saved values.."));
+    Serial.print(F("Date and Time is "));
+    Serial.print(hourValue);
+    Serial.print(F(":"));
+    Serial.print(minuteValue);
+    Serial.print(F(":"));
+    Serial.print(secondValue);
+    Serial.print(F(" "));
 
-    #ifdef ISL1208_RTC_DEBUG
-      Serial.println();
-      Serial.println(F("Updating time from saved values.."));
-      Serial.print(F("Date and Time is "));
-      Serial.print(hourValue);
-      Serial.print(F(":"));
-      Serial.print(minuteValue);
-      Serial.print(F(":"));
-      Serial.print(secondValue);
-      Serial.print(F(" "));
-
-      if (periodValue == 1) Serial.print(F("PM, "));
-      else Serial.print(F("AM, "));
-
-      Serial.print(dateValue);
-      Serial.print(F("-"));
-      Serial.print(monthValue);
-      Serial.print(F("-"));
-      Serial.print(yearValue);
-      Serial.print(F(", "));
-      Serial.println(dayNamesArray[(startOfTheWeek + dayValue) % 7]);
-    #endif
+    if (periodValue == 1) Serial.print(F("PM, "));
+    else Serial.print(F("AM, "));
 
-    //write to time register
-    Wire.beginTransmission(ISL1208_ADDRESS); //send the I2C address of RTC
-    Wire.write(ISL1208_SC); //starting address of time register
-    Wire.write(decToBcd(secondValue)); //convert the DEC value to BCD and send
-    Wire.write(decToBcd(minuteValue));
+    Serial.print(dateValue);
+    Serial.print(F("-"));
+    Serial.print(monthValue);
+    Serial.print(F("-"));
+    Serial.print(yearValue);
+    Serial.print(F(", "));
+    Serial.println(dayNamesArray[(startOfTheWeek + dayValue) % 7]);
+  #endif
 
-    //make a copy of the original variable so we don't lose the DEC formatted values
-    tempByte = decToBcd(hourValue); //convert to BCD
-    if (periodValue == 1) tempByte |= B00100000; //if PM (1 = PM)
-    else tempByte &= B00011111; //if AM (0 = AM)
-    Wire.write(tempByte); //write the modified hour value with AM/PM
+  //write to time register
+  byte timeData[7];
 
-    Wire.write(decToBcd(dateValue));
-    Wire.write(decToBcd(monthValue));
-    Wire.write(decToBcd(yearValue));
-    Wire.write(decToBcd(dayValue));
-    Wire.endTransmission();
+  if (!encodeTime(timeData)) { //the UTC time is not within 2000 to 2099
+    lastError = ISL1208_ERROR_INVALID_DATA;
+    return false;
   }
 
-  return true;
+  return writeRegisters(ISL1208_SC, timeData, 7); //starting address of time register
 }
 
 //========================================================================//
@@ -153,18 +438,23 @@ bool ISL1208_RTC::updateTime() {
 //over serial console. do not use terminating characters such as NL.
 
 bool ISL1208_RTC::setTime (String timeString) {
-  if (!isRtcActive()) {
-    return false;
-  }
+  return setTime(timeString.c_str());
+}
+
+//========================================================================//
+//parses the time string in place without creating any String objects.
+
+bool ISL1208_RTC::setTime (const char *timeString) {
+  size_t stringLength = strlen(timeString);
 
-  if (timeString.length() != 16) { //check if time inputs are valid
+  if (stringLength != 16) { //check if time inputs are valid
     Serial.flush();
     Serial.print(F("Invalid time input - "));
     Serial.print(timeString);
     Serial.print(F(", "));
-    Serial.println(timeString.length());
+    Serial.println(stringLength);
     
-    if (timeString.length() == 15) {
+    if (stringLength == 15) {
       Serial.println(F("You might be using the old format TYYMMDDhhmmssp#. The new format is TYYMMDDhhmmsspd# which also includes day value."));
       Serial.println(F("Please use the new format."));
     }
@@ -174,7 +464,7 @@ bool ISL1208_RTC::setTime (String timeString) {
 
   else {
     //Time format is : T17122410304213# (TYYMMDDhhmmsspd#)
-    if (timeString.charAt(0) == 'T') { //update time register
+    if (timeString[0] == 'T') { //update time register
 
       #ifdef ISL1208_RTC_DEBUG
         Serial.println();
@@ -182,27 +472,27 @@ bool ISL1208_RTC::setTime (String timeString) {
         Serial.println(timeString);
       #endif
 
-      timeString.remove(0,1); //remove 'T'
-      timeString.remove(15); //remove delimiter '#'
-
-      yearValue = byte((timeString.substring(0, 2)).toInt()); //convert string values to decimals
-      monthValue = byte((timeString.substring(2, 4)).toInt());
-      dateValue = byte((timeString.substring(4, 6)).toInt());
-      hourValue = byte((timeString.substring(6, 8)).toInt());
-      minuteValue = byte((timeString.substring(8, 10)).toInt());
-      secondValue = byte((timeString.substring(10, 12)).toInt());
-      periodValue = byte((timeString.substring(12, 13)).toInt());
-      dayValue = byte((timeString.substring(13)).toInt());
-
-      if ((yearValue > 99) || (monthValue > 12) || (monthValue < 1) || (dateValue > 31) || (dateValue < 1) || (hourValue > 23) ||
-        (minuteValue > 59) || (secondValue > 59) || (dayValue > 6)) {
+      //skip 'T' and convert the digits to decimals. the delimiter '#' is ignored.
+      yearValue = charsToDec(timeString + 1, 2);
+      monthValue = charsToDec(timeString + 3, 2);
+      dateValue = charsToDec(timeString + 5, 2);
+      hourValue = charsToDec(timeString + 7, 2);
+      minuteValue = charsToDec(timeString + 9, 2);
+      secondValue = charsToDec(timeString + 11, 2);
+      periodValue = charsToDec(timeString + 13, 1);
+      //the day value in the string is ignored. it is calculated from the date.
+
+      if (!isTimeValid()) {
           #ifdef ISL1208_RTC_DEBUG
             Serial.print(F("Invalid Date and Time"));
           #endif
 
+          lastError = ISL1208_ERROR_INVALID_DATA;
           return false;
       }
 
+      dayValue = calculateDay();
+
       #ifdef ISL1208_RTC_DEBUG
         Serial.print(F("Date and Time is "));
         Serial.print(hourValue);
@@ -225,23 +515,14 @@ bool ISL1208_RTC::setTime (String timeString) {
       #endif
 
       //write to time register
-      Wire.beginTransmission(ISL1208_ADDRESS); //send the I2C address of RTC
-      Wire.write(ISL1208_SC); //starting address of time register
-      Wire.write(decToBcd(secondValue)); //convert the dec value to BCD ans send
-      Wire.write(decToBcd(minuteValue));
-
-      hourValue = decToBcd(hourValue); //convert to BCD
-      if (periodValue == 1) hourValue |= B00100000; //if PM (1 = PM)
-      else hourValue &= B00011111; //if AM (0 = AM)
-      Wire.write(hourValue); //write the modified hour value with AM/PM
-
-      Wire.write(decToBcd(dateValue));
-      Wire.write(decToBcd(monthValue));
-      Wire.write(decToBcd(yearValue));
-      Wire.write(decToBcd(dayValue));
-      Wire.endTransmission();
-
-      // isTimeSet = true;
+      byte timeData[7];
+
+      if (!encodeTime(timeData)) { //the UTC time is not within 2000 to 2099
+        lastError = ISL1208_ERROR_INVALID_DATA;
+        return false;
+      }
+
+      return writeRegisters(ISL1208_SC, timeData, 7); //starting address of time register
     }
   }
 
@@ -253,64 +534,49 @@ bool ISL1208_RTC::setTime (String timeString) {
 //first save time values to the variables and call this function.
 
 bool ISL1208_RTC::updateAlarmTime() {
-  if (!isRtcActive()) {
-    return false;
-  }
-
-  else {
-    if ((monthValueAlarm > 12) || (monthValueAlarm < 1) || (dateValueAlarm > 31) || (dateValueAlarm < 1) || (hourValueAlarm > 23) ||
-      (minuteValueAlarm > 59) || (secondValueAlarm > 59) || (dayValueAlarm > 6)) {
-        #ifdef ISL1208_RTC_DEBUG
-          Serial.print(F("Invalid alarm Date and Time"));
-        #endif
+  BusCall busCall(*this);
+  if ((dateValueAlarm < 1) || (dateValueAlarm > ISL1208_Calendar::daysInMonth(0, monthValueAlarm)) || !isHourValid(hourValueAlarm) ||
+    (minuteValueAlarm > 59) || (secondValueAlarm > 59) || (dayValueAlarm > 6)) {
+      #ifdef ISL1208_RTC_DEBUG
+        Serial.print(F("Invalid alarm Date and Time"));
+      #endif
 
-        return false;
-    }
+      lastError = ISL1208_ERROR_INVALID_DATA;
+      return false;
+  }
 
-    #ifdef ISL1208_RTC_DEBUG
-      Serial.println();
-      Serial.println(F("Updating alarm time from saved values.."));
-      Serial.print(F("Alarm Date and Time is "));
-      Serial.print(hourValueAlarm);
-      Serial.print(F(":"));
-      Serial.print(minuteValueAlarm);
-      Serial.print(F(":"));
-      Serial.print(secondValueAlarm);
-      Serial.print(F(" "));
-
-      if (periodValueAlarm == 1) Serial.print(F("PM, "));
-      else Serial.print(F("AM, "));
-
-      Serial.print(dateValueAlarm);
-      Serial.print(F("-"));
-      Serial.print(monthValueAlarm);
-      Serial.println(F(" Every year"));
-      Serial.println(F(", "));
-      Serial.print(F("Day of week  "));
-      Serial.print(F(":  "));
-      Serial.println(dayNamesArray[(startOfTheWeek + dayValueAlarm) % 7]);
-    #endif
+  #ifdef ISL1208_RTC_DEBUG
+    Serial.println();
+    Serial.println(F("Updating alarm time from saved values.."));
+    Serial.print(F("Alarm Date and Time is "));
+    Serial.print(hourValueAlarm);
+    Serial.print(F(":"));
+    Serial.print(minuteValueAlarm);
+    Serial.print(F(":"));
+    Serial.print(secondValueAlarm);
+    Serial.print(F(" "));
 
-    //write to alarm register
-    Wire.beginTransmission(ISL1208_ADDRESS);
-    Wire.write(ISL1208_SCA); //alarm seconds register
-    Wire.write((B10000000 | (decToBcd(secondValueAlarm)))); //the OR operation is required to enable the alarm register
-    Wire.write((B10000000 | (decToBcd(minuteValueAlarm))));
+    if (periodValueAlarm == 1) Serial.print(F("PM, "));
+    else Serial.print(F("AM, "));
 
-    hourValueAlarm = decToBcd(hourValueAlarm); //convert to BCD
-    if (periodValueAlarm == 1) hourValueAlarm |= B00100000; //if PM (1 = PM)
-    else hourValueAlarm &= B00011111; //if AM (0 = AM)
-    Wire.write((B10000000 | hourValue)); //write the modified hour value with AM/PM
+    Serial.print(dateValueAlarm);
+    Serial.print(F("-"));
+    Serial.print(monthValueAlarm);
+    Serial.println(F(" Every year"));
+    Serial.println(F(", "));
+    Serial.print(F("Day of week  "));
+    Serial.print(F(":  "));
+    Serial.println(dayNamesArray[(startOfTheWeek + dayValueAlarm) % 7]);
+  #endif
 
-    Wire.write((B10000000 | (decToBcd(dateValueAlarm))));
-    Wire.write((B10000000 | (decToBcd(monthValueAlarm))));
-    Wire.write(decToBcd(dayValueAlarm));
-    Wire.endTransmission();
+  //write to alarm register
+  byte alarmData[6];
 
-    // isAlarmSet = true;
+  if (!encodeAlarmTime(alarmData)) {
+    return false;
   }
 
-  return true;
+  return writeRegisters(ISL1208_SCA, alarmData, 6); //alarm seconds register
 }
 
 //========================================================================//
@@ -320,19 +586,25 @@ bool ISL1208_RTC::updateAlarmTime() {
 //do not use any terminating characters such as NL.
 
 bool ISL1208_RTC::setAlarmTime (String alarmString) {
-  if (!isRtcActive()) {
-    return false;
-  }
+  return setAlarmTime(alarmString.c_str());
+}
+
+//========================================================================//
+//parses the alarm string in place without creating any String objects.
+
+bool ISL1208_RTC::setAlarmTime (const char *alarmString) {
+  BusCall busCall(*this);
+  size_t stringLength = strlen(alarmString);
 
   //Alarm time format is AMMDDhhmmsspd# 
-  if (alarmString.length() != 14) { //check if time input is valid
+  if (stringLength != 14) { //check if time input is valid
     Serial.flush();
     Serial.print(F("Invalid time input - "));
     Serial.print(alarmString);
     Serial.print(F(", "));
-    Serial.println(alarmString.length());
+    Serial.println(stringLength);
 
-    if (alarmString.length() == 13) {
+    if (stringLength == 13) {
       Serial.println(F("You might be using the old format AMMDDhhmmssp#. The new format is AMMDDhhmmsspd# which also includes day value."));
       Serial.println(F("Please use the new format."));
     }
@@ -341,30 +613,29 @@ bool ISL1208_RTC::setAlarmTime (String alarmString) {
   }
 
   else {
-    if (alarmString.charAt(0) == 'A') { //update alarm register
+    if (alarmString[0] == 'A') { //update alarm register
       #ifdef ISL1208_RTC_DEBUG
         Serial.println();
         Serial.print(F("Alarm update received = "));
         Serial.println(alarmString);
       #endif
 
-      alarmString.remove(0,1); //remove 'A'
-      alarmString.remove(13); //remove delimiter #
+      //skip 'A' and convert the digits to decimals. the delimiter '#' is ignored.
+      monthValueAlarm = charsToDec(alarmString + 1, 2);
+      dateValueAlarm = charsToDec(alarmString + 3, 2);
+      hourValueAlarm = charsToDec(alarmString + 5, 2);
+      minuteValueAlarm = charsToDec(alarmString + 7, 2);
+      secondValueAlarm = charsToDec(alarmString + 9, 2);
+      periodValueAlarm = charsToDec(alarmString + 11, 1);
+      dayValueAlarm = charsToDec(alarmString + 12, 1);
 
-      monthValueAlarm = byte((alarmString.substring(0, 2)).toInt()); //convert string values to decimals
-      dateValueAlarm = byte((alarmString.substring(2, 4)).toInt());
-      hourValueAlarm = byte((alarmString.substring(4, 6)).toInt());
-      minuteValueAlarm = byte((alarmString.substring(6, 8)).toInt());
-      secondValueAlarm = byte((alarmString.substring(8, 10)).toInt());
-      periodValueAlarm = byte((alarmString.substring(10, 11)).toInt());
-      dayValueAlarm = byte((alarmString.substring(11)).toInt());
-
-      if ((monthValueAlarm > 12) || (monthValueAlarm < 1) || (dateValueAlarm > 31) || (dateValueAlarm < 1) || (hourValueAlarm > 23) ||
+      if ((dateValueAlarm < 1) || (dateValueAlarm > ISL1208_Calendar::daysInMonth(0, monthValueAlarm)) || !isHourValid(hourValueAlarm) ||
         (minuteValueAlarm > 59) || (secondValueAlarm > 59) || (dayValueAlarm > 6)) {
           #ifdef ISL1208_RTC_DEBUG
             Serial.print(F("Invalid alarm Date and Time"));
           #endif
 
+          lastError = ISL1208_ERROR_INVALID_DATA;
           return false;
       }
 
@@ -390,22 +661,13 @@ bool ISL1208_RTC::setAlarmTime (String alarmString) {
       #endif
 
       //write to alarm register
-      Wire.beginTransmission(ISL1208_ADDRESS);
-      Wire.write(ISL1208_SCA); //alarm seconds register
-      Wire.write((B10000000 | (decToBcd(secondValueAlarm)))); //the OR operation is required to enable the alarm register
-      Wire.write((B10000000 | (decToBcd(minuteValueAlarm))));
-
-      hourValueAlarm = decToBcd(hourValueAlarm); //convert to BCD
-      if (periodValueAlarm == 1) hourValueAlarm |= B00100000; //if PM (1 = PM)
-      else hourValueAlarm &= B00011111; //if AM (0 = AM)
-      Wire.write((B10000000 | hourValue)); //write the modified hour value with AM/PM
-
-      Wire.write((B10000000 | (decToBcd(dateValueAlarm))));
-      Wire.write((B10000000 | (decToBcd(monthValueAlarm))));
-      Wire.write(decToBcd(dayValueAlarm));
-      Wire.endTransmission();
-    
-      // isAlarmSet = true;
+      byte alarmData[6];
+
+      if (!encodeAlarmTime(alarmData)) {
+        return false;
+      }
+
+      return writeRegisters(ISL1208_SCA, alarmData, 6); //alarm seconds register
     }
 
     else return false;
@@ -416,59 +678,77 @@ bool ISL1208_RTC::setAlarmTime (String alarmString) {
 
 //========================================================================//
 //fetches current time and alarm values from RTC and save to variables.
+//with a time zone, the time and the alarm are converted to local time.
 
 bool ISL1208_RTC::fetchTime() {
-  if (!isRtcActive()) {
+  BusCall busCall(*this);
+  byte timeData[7];
+  ISL1208_DateTime currentTime; //RTC time
+
+  //the variables are left untouched if the read fails
+  if (!readRegisters(ISL1208_SC, timeData, 7)) { //time seconds register
     return false;
   }
 
-  else {
-    Wire.beginTransmission(ISL1208_ADDRESS); //send I2C address of RTC
-    Wire.write(ISL1208_SC); //time seconds register
-    Wire.endTransmission();
-
-    Wire.requestFrom(ISL1208_ADDRESS,7); // now get the bytes of data
-
-    secondValue = bcdToDec(Wire.read()); //read 6 bytes of data and convert them to DEC
-    minuteValue = bcdToDec(Wire.read());
-    hourValue = Wire.read();
+  bool isMilFormat = (timeData[2] & B10000000) != 0; //MIL bit. the alarm hour uses the same format
 
-    if ((hourValue & B00100000) == 0) { //check HR21 bit (AM/PM)
-      periodValue = 0; //AM
-    }
-    else {
-      periodValue = 1; //PM
+  if (timeZone == NULL) {
+    secondValue = bcdToDec(timeData[0]); //convert the 7 bytes of data to DEC
+    minuteValue = bcdToDec(timeData[1]);
+    splitHour(decodeHour(timeData[2], isMilFormat), hourValue, periodValue);
+    dateValue = bcdToDec(timeData[3]);
+    monthValue = bcdToDec(timeData[4]);
+    yearValue = bcdToDec(timeData[5]);
+    dayValue = bcdToDec(timeData[6]);
+  }
+  else { //the RTC keeps UTC. convert it to local time
+    decodeDateTime(timeData, currentTime);
+    ISL1208_DateTime localTime = currentTime;
+
+    //an invalid time can't be converted
+    if (!timeZone->toLocal(localTime)) {
+      lastError = ISL1208_ERROR_INVALID_DATA;
+      return false;
     }
 
-    hourValue = bcdToDec(hourValue & B00011111);
-    dateValue = bcdToDec(Wire.read());
-    monthValue = bcdToDec(Wire.read());
-    yearValue = bcdToDec(Wire.read());
-    dayValue = bcdToDec(Wire.read());
-
-    Wire.beginTransmission(ISL1208_ADDRESS);
-    Wire.write(ISL1208_SCA); //alarm seconds register
-    Wire.endTransmission();
+    fromDateTime(localTime);
+  }
 
-    Wire.requestFrom(ISL1208_ADDRESS,6); // now get the byte of data
+  byte alarmData[6];
 
-    //AND operation is to remove the ENABLE bit (MSB) of each register value
-    secondValueAlarm = bcdToDec(B01111111 & Wire.read());
-    minuteValueAlarm = bcdToDec(B01111111 & Wire.read());
-    hourValueAlarm = B01111111 & Wire.read();
+  if (!readRegisters(ISL1208_SCA, alarmData, 6)) { //alarm seconds register
+    return false;
+  }
 
-    if ((hourValueAlarm & B00100000) == 0) { //check HR21 bit (AM/PM)
-      periodValueAlarm = 0; //AM
-    }
-    else {
-      periodValueAlarm = 1; //PM
+  //AND operation is to remove the ENABLE bit (MSB) of each register value
+  secondValueAlarm = bcdToDec(B01111111 & alarmData[0]);
+  minuteValueAlarm = bcdToDec(B01111111 & alarmData[1]);
+  splitHour(decodeHour(B01111111 & alarmData[2], isMilFormat), hourValueAlarm, periodValueAlarm);
+  dateValueAlarm = bcdToDec(B01111111 & alarmData[3]);
+  monthValueAlarm = bcdToDec(B01111111 & alarmData[4]);
+  dayValueAlarm = bcdToDec(B01111111 & alarmData[5]);
+
+  //the alarm registers are also in UTC. the alarm is converted at its next
+  //match, so the DST offset is the one in effect when it fires. an alarm
+  //that was never set is left as it is.
+  if (timeZone != NULL) {
+    ISL1208_DateTime alarmTime;
+    alarmTime.month = monthValueAlarm;
+    alarmTime.date = dateValueAlarm;
+    alarmTime.hour = decodeHour(B01111111 & alarmData[2], isMilFormat);
+    alarmTime.minute = minuteValueAlarm;
+    alarmTime.second = secondValueAlarm;
+
+    if (setAlarmYear(alarmTime, currentTime) && timeZone->toLocal(alarmTime)) {
+      monthValueAlarm = alarmTime.month;
+      dateValueAlarm = alarmTime.date;
+      splitHour(alarmTime.hour, hourValueAlarm, periodValueAlarm);
+      minuteValueAlarm = alarmTime.minute;
+      secondValueAlarm = alarmTime.second;
+      dayValueAlarm = (alarmTime.day + 7 - (startOfTheWeek % 7)) % 7;
     }
-
-    hourValueAlarm = bcdToDec(hourValueAlarm & B00011111);
-    dateValueAlarm = bcdToDec(B01111111 & Wire.read());
-    monthValueAlarm = bcdToDec(B01111111 & Wire.read());
-    dayValueAlarm = bcdToDec(B01111111 & Wire.read());
   }
+
   return true;
 }
 
@@ -578,127 +858,754 @@ int ISL1208_RTC::getAlarmMonth() {
 }
 
 //========================================================================//
-//converts the BCD read from RTC register to DEC for transmission.
+//reads the status register. the bits are defined in the datasheet
+//(ARST, XTOSCB, WRTC, ALM, BAT, RTCF). if ARST is set, the read clears ALM
+//and BAT. they are still reported by ISL1208_DutyCycle::wake().
 
-byte ISL1208_RTC::bcdToDec (byte val) {
-  return ((val/16*10) + (val%16));
+int ISL1208_RTC::getStatus() {
+  byte statusValue;
+
+  if (!readRegisters(ISL1208_SR, &statusValue, 1)) {
+    return -1;
+  }
+
+  saveStatus(statusValue);
+  return statusValue;
 }
 
 //========================================================================//
-//converts the DEC input values to BCD in order to update the RTC register.
+//the RTC clears ALM and BAT after a status register read when ARST is set.
+//the flags are kept here, so that the wake up cause isn't lost when the
+//status is read before ISL1208_DutyCycle::wake().
 
-byte ISL1208_RTC::decToBcd (byte val) {
-  return ((val/10*16) + (val%10));
+void ISL1208_RTC::saveStatus (byte statusValue) {
+  if (statusValue & ISL1208_SR_ARST) {
+    clearedStatus |= statusValue & (ISL1208_SR_ALM | ISL1208_SR_BAT);
+  }
 }
 
 //========================================================================//
+//the ISL1208 has 2 bytes of battery backed user memory. index 0 is USR1
+//and 1 is USR2.
 
-String ISL1208_RTC::getTimeString() {
-  String tempString = String(getHour());
-  tempString += ':';
-  tempString += String(getMinute());
-  tempString += ':';
-  tempString += String(getSecond());
-  tempString += ' ';
-  if (getPeriod() == 0) tempString += "AM";
-  else tempString += "PM";
+int ISL1208_RTC::getUserMemory (byte index) {
+  byte memoryValue;
+
+  if ((index > 1) || !readRegisters(ISL1208_USR1 + index, &memoryValue, 1)) {
+    return -1;
+  }
 
-  return tempString;
+  return memoryValue;
 }
 
 //========================================================================//
 
-String ISL1208_RTC::getDateString() {
-  String tempString = String(getDate());
-  tempString += '-';
-  tempString += String(getMonth());
-  tempString += '-';
-  tempString += String(getYear() + 2000);
+bool ISL1208_RTC::setUserMemory (byte index, byte memoryValue) {
+  if (index > 1) {
+    lastError = ISL1208_ERROR_INVALID_DATA;
+    return false;
+  }
 
-  return tempString;
+  return writeRegisters(ISL1208_USR1 + index, &memoryValue, 1);
 }
 
 //========================================================================//
+//reads a user memory byte, clears the bits in clearMask, sets the bits in
+//setMask and writes it back. nothing is written if the read fails.
 
-String ISL1208_RTC::getDayString() {
-  return dayNamesArray[(startOfTheWeek + getDay()) % 7];
-}
+bool ISL1208_RTC::modifyUserMemory (byte index, byte clearMask, byte setMask) {
+  BusCall busCall(*this);
+  int memoryValue = getUserMemory(index);
 
-//========================================================================//
+  if (memoryValue < 0) {
+    return false;
+  }
 
-String ISL1208_RTC::getDayString (int n) {
-  String tempString = getDayString();
-  tempString.remove(n);
-  return tempString;
+  return setUserMemory(index, (byte(memoryValue) & ~clearMask) | setMask);
 }
 
 //========================================================================//
+//the 16-bit value is saved with the high byte in USR1 and the low byte in
+//USR2. both bytes are written in one transfer, high byte first. so if the
+//power fails in the middle of writing a larger value, the register holds a
+//value between the old and the new one, never a smaller one.
 
-String ISL1208_RTC::getAlarmDayString() {
-  return dayNamesArray[(startOfTheWeek + getAlarmDay()) % 7];
-}
+bool ISL1208_RTC::getUserWord (uint16_t &wordValue) {
+  byte memoryData[2];
 
-//========================================================================//
+  if (!readRegisters(ISL1208_USR1, memoryData, 2)) {
+    return false;
+  }
 
-String ISL1208_RTC::getAlarmDayString (int n) {
-  String tempString = getAlarmDayString();
-  tempString.remove(n);
-  return tempString;
+  wordValue = ((uint16_t) memoryData[0] << 8) | memoryData[1];
+  return true;
 }
 
 //========================================================================//
 
-String ISL1208_RTC::getDateDayString() {
-  String tempString = getDateString();
-  tempString += ", ";
-  tempString += getDayString();
+bool ISL1208_RTC::setUserWord (uint16_t wordValue) {
+  byte memoryData[2];
+  memoryData[0] = byte(wordValue >> 8);
+  memoryData[1] = byte(wordValue);
 
-  return tempString;
+  return writeRegisters(ISL1208_USR1, memoryData, 2);
 }
 
 //========================================================================//
+//same as modifyUserMemory() but for both bytes.
 
-String ISL1208_RTC::getDateDayString (int n) {
-  String tempString = getDateString();
-  tempString += ", ";
-  tempString += getDayString(n);
+bool ISL1208_RTC::modifyUserWord (uint16_t clearMask, uint16_t setMask) {
+  BusCall busCall(*this);
+  uint16_t wordValue;
+
+  if (!getUserWord(wordValue)) {
+    return false;
+  }
 
-  return tempString;
+  return setUserWord((wordValue & ~clearMask) | setMask);
 }
 
 //========================================================================//
+//reads the time and returns it as seconds since 2000-01-01 00:00:00 UTC.
+//a 32-bit value covers all the years the RTC can hold (2000 to 2099).
+//returns 0 if the read fails or the registers hold an invalid time.
 
-String ISL1208_RTC::getTimeDateString() {
-  String tempString = getTimeString();
-  tempString += ", ";
-  tempString += getDateString();
+uint32_t ISL1208_RTC::getEpoch() {
+  uint32_t epochTime;
+
+  if (!getEpoch(epochTime)) {
+    return 0;
+  }
 
-  return tempString;
+  return epochTime;
 }
 
 //========================================================================//
+//reads only the time registers. the time variables are not changed.
+//the epoch is UTC whether a time zone is set or not.
 
-String ISL1208_RTC::getTimeDateDayString() {
-  String tempString = getTimeString();
-  tempString += ", ";
-  tempString += getDateString();
-  tempString += ", ";
-  tempString += getDayString();
+bool ISL1208_RTC::getEpoch (uint32_t &epochTime) {
+  ISL1208_DateTime dateTime;
 
-  return tempString;
+  if (!readTime(dateTime)) {
+    return false;
+  }
+
+  epochTime = ISL1208_Calendar::toEpoch(dateTime);
+  return true;
+}
+
+//========================================================================//
+//writes a UTC time to the RTC. the time variables are not changed.
+
+bool ISL1208_RTC::setEpoch (uint32_t epochTime) {
+  ISL1208_DateTime dateTime;
+  byte timeData[7];
+
+  if (!ISL1208_Calendar::fromEpoch(epochTime, dateTime)) {
+    lastError = ISL1208_ERROR_INVALID_DATA;
+    return false;
+  }
+
+  encodeDateTime(dateTime, timeData);
+  return writeRegisters(ISL1208_SC, timeData, 7);
+}
+
+//========================================================================//
+//converts the time variables to seconds since 2000-01-01 00:00:00 UTC
+//without reading the RTC. returns ISL1208_EPOCH_INVALID if a variable is out
+//of range. with a time zone, a local time in the hour repeated at the end of
+//DST is taken as DST, so use getEpoch() to read the current time.
+
+uint32_t ISL1208_RTC::toEpoch() {
+  ISL1208_DateTime dateTime;
+
+  if (!isTimeValid()) {
+    return ISL1208_EPOCH_INVALID;
+  }
+
+  toDateTime(dateTime);
+  uint32_t epochTime = ISL1208_Calendar::toEpoch(dateTime);
+
+  if (timeZone != NULL) {
+    epochTime = timeZone->toUtc(epochTime);
+  }
+
+  return epochTime;
+}
+
+//========================================================================//
+//sets the time variables from seconds since 2000-01-01 00:00:00 UTC.
+//call updateTime() after this to write the time to the RTC. the variables
+//are left unchanged if the time or the local time is after 2099.
+
+bool ISL1208_RTC::fromEpoch (uint32_t epochTime) {
+  ISL1208_DateTime dateTime;
+
+  if (timeZone != NULL) {
+    epochTime = timeZone->toLocal(epochTime);
+  }
+
+  if (!ISL1208_Calendar::fromEpoch(epochTime, dateTime)) {
+    return false;
+  }
+
+  fromDateTime(dateTime);
+  return true;
+}
+
+//========================================================================//
+//reads the RTC and saves the time to a snapshot in 24 hour format.
+
+bool ISL1208_RTC::getDateTime (ISL1208_DateTime &dateTime) {
+  if (!fetchTime()) {
+    return false;
+  }
+
+  toDateTime(dateTime);
+  return true;
+}
+
+//========================================================================//
+//writes the time from a snapshot to the RTC. the day of the week in the
+//snapshot is not used.
+
+bool ISL1208_RTC::setDateTime (const ISL1208_DateTime &dateTime) {
+  fromDateTime(dateTime);
+  return updateTime();
+}
+
+//========================================================================//
+//converts the time variables to a snapshot without reading the RTC.
+
+void ISL1208_RTC::toDateTime (ISL1208_DateTime &dateTime) {
+  dateTime.year = yearValue;
+  dateTime.month = monthValue;
+  dateTime.date = dateValue;
+  dateTime.hour = getHour24(hourValue, periodValue);
+  dateTime.minute = minuteValue;
+  dateTime.second = secondValue;
+  dateTime.day = (startOfTheWeek + dayValue) % 7;
+}
+
+//========================================================================//
+//sets the time variables from a snapshot. the day of the week is
+//calculated from the date.
+
+void ISL1208_RTC::fromDateTime (const ISL1208_DateTime &dateTime) {
+  yearValue = dateTime.year;
+  monthValue = dateTime.month;
+  dateValue = dateTime.date;
+  minuteValue = dateTime.minute;
+  secondValue = dateTime.second;
+
+  splitHour(dateTime.hour, hourValue, periodValue);
+
+  if (ISL1208_Calendar::daysInMonth(yearValue, monthValue) > 0) { //only if the month is valid
+    dayValue = calculateDay();
+  }
+}
+
+//========================================================================//
+//sets a time zone for converting between the local time in the variables
+//and the UTC time in the RTC. pass NULL to use the RTC time as it is.
+//when a time zone is set, the time and alarm variables, snapshots and
+//strings are in local time. epochs are always UTC.
+
+void ISL1208_RTC::setTimeZone (ISL1208_TimeZone *zone) {
+  timeZone = zone;
 }
 
+//========================================================================//
+//converts the time variables to the 7 bytes of the time registers, from
+//seconds to day of the week. the time is converted to UTC if a time zone
+//is set. returns false if the UTC time is not within 2000 to 2099.
+
+bool ISL1208_RTC::encodeTime (byte *timeData) {
+  ISL1208_DateTime dateTime;
+  toDateTime(dateTime);
+
+  if ((timeZone != NULL) && !timeZone->toUtc(dateTime)) {
+    return false;
+  }
+
+  encodeDateTime(dateTime, timeData);
+  return true;
+}
+
+//========================================================================//
+//converts a 24 hour snapshot to the 7 bytes of the time registers.
+
+void ISL1208_RTC::encodeDateTime (const ISL1208_DateTime &dateTime, byte *timeData) {
+  timeData[0] = decToBcd(dateTime.second); //convert the DEC value to BCD
+  timeData[1] = decToBcd(dateTime.minute);
+  timeData[2] = encodeHour(dateTime.hour);
+  timeData[3] = decToBcd(dateTime.date);
+  timeData[4] = decToBcd(dateTime.month);
+  timeData[5] = decToBcd(dateTime.year);
+  timeData[6] = decToBcd((dateTime.day + 7 - (startOfTheWeek % 7)) % 7);
+}
+
+//========================================================================//
+//converts the 7 bytes of the time registers to a 24 hour snapshot. the
+//values are not checked.
+
+void ISL1208_RTC::decodeDateTime (const byte *timeData, ISL1208_DateTime &dateTime) {
+  dateTime.second = bcdToDec(timeData[0]);
+  dateTime.minute = bcdToDec(timeData[1]);
+  dateTime.hour = decodeHour(timeData[2], (timeData[2] & B10000000) != 0);
+  dateTime.date = bcdToDec(timeData[3]);
+  dateTime.month = bcdToDec(timeData[4]);
+  dateTime.year = bcdToDec(timeData[5]);
+  dateTime.day = (startOfTheWeek + bcdToDec(timeData[6])) % 7;
+}
+
+//========================================================================//
+//reads the time registers to a snapshot without converting it or changing
+//the variables. fails with ISL1208_ERROR_INVALID_DATA if the time is invalid.
+
+bool ISL1208_RTC::readTime (ISL1208_DateTime &dateTime) {
+  byte timeData[7];
+
+  if (!readRegisters(ISL1208_SC, timeData, 7)) {
+    return false;
+  }
+
+  decodeDateTime(timeData, dateTime);
+
+  if (!ISL1208_Calendar::isValid(dateTime)) {
+    lastError = ISL1208_ERROR_INVALID_DATA;
+    return false;
+  }
+
+  return true;
+}
+
+//========================================================================//
+//converts the alarm variables to the 6 bytes of the alarm registers, with
+//the seconds, minutes, hours, date and month matched. with a time zone, the
+//alarm is converted to UTC at its next match after the current time, which
+//is read from the RTC, and the day of the week is calculated from the date.
+
+bool ISL1208_RTC::encodeAlarmTime (byte *alarmData) {
+  ISL1208_DateTime alarmTime;
+  alarmTime.month = monthValueAlarm;
+  alarmTime.date = dateValueAlarm;
+  alarmTime.hour = getHour24(hourValueAlarm, periodValueAlarm);
+  alarmTime.minute = minuteValueAlarm;
+  alarmTime.second = secondValueAlarm;
+  alarmTime.day = dayValueAlarm;
+
+  if (timeZone != NULL) {
+    ISL1208_DateTime currentTime;
+
+    if (!readTime(currentTime)) {
+      return false;
+    }
+
+    if (!timeZone->toLocal(currentTime) || !setAlarmYear(alarmTime, currentTime) || !timeZone->toUtc(alarmTime)) {
+      lastError = ISL1208_ERROR_INVALID_DATA;
+      return false;
+    }
+
+    alarmTime.day = (alarmTime.day + 7 - (startOfTheWeek % 7)) % 7;
+  }
+
+  encodeAlarm(alarmTime, alarmData);
+  return true;
+}
+
+//========================================================================//
+//converts a 24 hour snapshot to the 6 bytes of the alarm registers. the
+//year is not used and the day of the week is written as it is, but not
+//matched.
+
+void ISL1208_RTC::encodeAlarm (const ISL1208_DateTime &alarmTime, byte *alarmData) {
+  alarmData[0] = B10000000 | decToBcd(alarmTime.second); //the OR operation is required to enable the alarm register
+  alarmData[1] = B10000000 | decToBcd(alarmTime.minute);
+  alarmData[2] = B10000000 | (B01111111 & encodeHour(alarmTime.hour)); //same format as the time register, without the MIL bit
+  alarmData[3] = B10000000 | decToBcd(alarmTime.date);
+  alarmData[4] = B10000000 | decToBcd(alarmTime.month);
+  alarmData[5] = decToBcd(alarmTime.day);
+}
+
+//========================================================================//
+//the alarm registers have no year. this sets the year of an alarm snapshot
+//to when it next matches at or after the given time. February 29 is in the
+//next leap year. returns false if that is after 2099.
+
+bool ISL1208_RTC::setAlarmYear (ISL1208_DateTime &alarmTime, const ISL1208_DateTime &currentTime) {
+  alarmTime.day = 0; //calculated by the conversion
+
+  for (alarmTime.year = currentTime.year; alarmTime.year <= 99; alarmTime.year++) {
+    if (ISL1208_Calendar::isValid(alarmTime) && (ISL1208_Calendar::compare(alarmTime, currentTime) >= 0)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//========================================================================//
+//selects the 24 hour (MIL) or 12 hour format. the hour registers of the RTC
+//are converted to the new format right away, so that the time and alarm
+//registers always use the same format. in 24 hour mode, hourValue is 0 to 23
+//and periodValue is only set on reads.
+//the previous format is taken from the MIL bit of the hour register, not from
+//the current mode, so calling this again with the same mode changes nothing.
+//the mode is only changed after both registers are written.
+
+bool ISL1208_RTC::set24HourMode (bool isEnabled) {
+  BusCall busCall(*this);
+  byte hourData;
+  byte alarmHourData;
+
+  if (!readRegisters(ISL1208_HR, &hourData, 1)) {
+    return false;
+  }
+
+  bool wasMilFormat = (hourData & B10000000) != 0; //MIL bit. the alarm hour uses the same format
+
+  if (wasMilFormat == isEnabled) { //already in this format
+    isMilMode = isEnabled;
+    return true;
+  }
+
+  if (!readRegisters(ISL1208_HRA, &alarmHourData, 1)) {
+    return false;
+  }
+
+  byte newHourData = encodeHour(decodeHour(hourData, wasMilFormat), isEnabled);
+  byte newAlarmHourData = (alarmHourData & B10000000) | (B01111111 & encodeHour(decodeHour(alarmHourData & B01111111, wasMilFormat), isEnabled)); //keep the enable bit. there's no MIL bit
+
+  if (!writeRegisters(ISL1208_HR, &newHourData, 1)) {
+    return false;
+  }
+
+  if (!writeRegisters(ISL1208_HRA, &newAlarmHourData, 1)) {
+    byte writeError = lastError;
+    writeRegisters(ISL1208_HR, &hourData, 1); //restore the previous format
+    lastError = writeError;
+    return false;
+  }
+
+  isMilMode = isEnabled;
+  return true;
+}
+
+//========================================================================//
+
+bool ISL1208_RTC::is24HourMode() {
+  return isMilMode;
+}
+
+//========================================================================//
+//converts a 24 hour value to the hour register format of the current mode.
+
+byte ISL1208_RTC::encodeHour (byte hour24) {
+  return encodeHour(hour24, isMilMode);
+}
+
+//========================================================================//
+//converts a 24 hour value to the hour register format of the given mode.
+
+byte ISL1208_RTC::encodeHour (byte hour24, bool isMilFormat) {
+  if (isMilFormat) {
+    return B10000000 | decToBcd(hour24); //MIL bit
+  }
+
+  byte hour12 = hour24 % 12;
+  if (hour12 == 0) hour12 = 12; //12 AM and 12 PM
+
+  if (hour24 >= 12) {
+    return B00100000 | decToBcd(hour12); //HR21 bit is set for PM
+  }
+
+  return decToBcd(hour12);
+}
+
+//========================================================================//
+//converts an hour register value to 24 hour format. the enable bit of the
+//alarm register must be removed first.
+
+byte ISL1208_RTC::decodeHour (byte hourData, bool isMilFormat) {
+  if (isMilFormat) {
+    return bcdToDec(hourData & B00111111);
+  }
+
+  byte hour24 = bcdToDec(hourData & B00011111) % 12; //12 AM is hour 0
+  if (hourData & B00100000) hour24 += 12; //check HR21 bit (AM/PM)
+  return hour24;
+}
+
+//========================================================================//
+//returns the 24 hour value of an hour variable and its period.
+
+byte ISL1208_RTC::getHour24 (byte hour, byte period) {
+  if (isMilMode) {
+    return hour;
+  }
+
+  return (hour % 12) + ((period == 1) ? 12 : 0);
+}
+
+//========================================================================//
+//sets an hour variable and its period from a 24 hour value.
+
+void ISL1208_RTC::splitHour (byte hour24, byte &hour, byte &period) {
+  period = (hour24 >= 12) ? 1 : 0;
+
+  if (isMilMode) {
+    hour = hour24;
+  }
+  else {
+    hour = hour24 % 12;
+    if (hour == 0) hour = 12; //12 AM and 12 PM
+  }
+}
+
+//========================================================================//
+//the hour is 0 to 23 in 24 hour mode and 1 to 12 in 12 hour mode.
+
+bool ISL1208_RTC::isHourValid (byte hour) {
+  if (isMilMode) {
+    return (hour <= 23);
+  }
+
+  return ((hour >= 1) && (hour <= 12));
+}
+
+//========================================================================//
+//returns the day value for the date in the variables. the day value is
+//counted from startOfTheWeek, the same way the day names are printed.
+
+byte ISL1208_RTC::calculateDay() {
+  return (ISL1208_Calendar::dayOfWeek(yearValue, monthValue, dateValue) + 7 - (startOfTheWeek % 7)) % 7;
+}
+
+//========================================================================//
+//checks the ranges of the time variables, including the days in the month.
+
+bool ISL1208_RTC::isTimeValid() {
+  if ((yearValue > 99) || (dateValue < 1) || (dateValue > ISL1208_Calendar::daysInMonth(yearValue, monthValue)) ||
+    !isHourValid(hourValue) || (minuteValue > 59) || (secondValue > 59)) {
+      return false;
+  }
+
+  return true;
+}
+
+//========================================================================//
+//converts a fixed number of decimal characters to a number. used by the
+//string parsers. returns 0xFF if a non-digit is found, which will then fail
+//the range checks.
+
+byte ISL1208_RTC::charsToDec (const char *digits, byte count) {
+  byte value = 0;
+
+  for (byte i = 0; i < count; i++) {
+    if ((digits[i] < '0') || (digits[i] > '9')) {
+      return 0xFF;
+    }
+
+    value = (value * 10) + (digits[i] - '0');
+  }
+
+  return value;
+}
+
+//========================================================================//
+//converts the BCD read from RTC register to DEC for transmission.
+
+byte ISL1208_RTC::bcdToDec (byte val) {
+  return (((val >> 4) * 10) + (val & 0x0F));
+}
+
+//========================================================================//
+//converts the DEC input values to BCD in order to update the RTC register.
+
+byte ISL1208_RTC::decToBcd (byte val) {
+  return ((val/10*16) + (val%10));
+}
+
+//========================================================================//
+
+String ISL1208_RTC::getTimeString() {
+  char tempString[ISL1208_STRING_SIZE];
+
+  fetchTime();
+  *appendTime(tempString) = '\0';
+  return String(tempString);
+}
+
+//========================================================================//
+
+String ISL1208_RTC::getDateString() {
+  char tempString[ISL1208_STRING_SIZE];
+
+  fetchTime();
+  *appendDate(tempString) = '\0';
+  return String(tempString);
+}
+
+//========================================================================//
+//returns the name of a day of the week, 0 = Sunday. add startOfTheWeek to
+//a day value before passing it.
+
+const char* ISL1208_RTC::getDayName (byte day) {
+  return dayNamesArray[day % 7];
+}
+
+//========================================================================//
+
+String ISL1208_RTC::getDayString() {
+  return String(dayNamesArray[(startOfTheWeek + getDay()) % 7]);
+}
+
+//========================================================================//
+
+String ISL1208_RTC::getDayString (int n) {
+  char tempString[ISL1208_STRING_SIZE];
+
+  fetchTime();
+  *appendDay(tempString, dayValue, n) = '\0';
+  return String(tempString);
+}
+
+//========================================================================//
+
+String ISL1208_RTC::getAlarmDayString() {
+  return String(dayNamesArray[(startOfTheWeek + getAlarmDay()) % 7]);
+}
+
+//========================================================================//
+
+String ISL1208_RTC::getAlarmDayString (int n) {
+  char tempString[ISL1208_STRING_SIZE];
+
+  fetchTime();
+  *appendDay(tempString, dayValueAlarm, n) = '\0';
+  return String(tempString);
+}
+
+//========================================================================//
+
+String ISL1208_RTC::getDateDayString() {
+  return getDateDayString(-1);
+}
+
+//========================================================================//
+
+String ISL1208_RTC::getDateDayString (int n) {
+  char tempString[ISL1208_STRING_SIZE];
+  char *stringEnd;
+
+  fetchTime();
+  stringEnd = appendDate(tempString);
+  *stringEnd++ = ',';
+  *stringEnd++ = ' ';
+  *appendDay(stringEnd, dayValue, n) = '\0';
+  return String(tempString);
+}
+
+//========================================================================//
+
+String ISL1208_RTC::getTimeDateString() {
+  char tempString[ISL1208_STRING_SIZE];
+  char *stringEnd;
+
+  fetchTime();
+  stringEnd = appendTime(tempString);
+  *stringEnd++ = ',';
+  *stringEnd++ = ' ';
+  *appendDate(stringEnd) = '\0';
+  return String(tempString);
+}
+
+//========================================================================//
+
+String ISL1208_RTC::getTimeDateDayString() {
+  return getTimeDateDayString(-1);
+}
 
 //========================================================================//
 
 String ISL1208_RTC::getTimeDateDayString (int n) {
-  String tempString = getTimeString();
-  tempString += ", ";
-  tempString += getDateString();
-  tempString += ", ";
-  tempString += getDayString(n);
+  char tempString[ISL1208_STRING_SIZE];
+  char *stringEnd;
 
-  return tempString;
+  fetchTime();
+  stringEnd = appendTime(tempString);
+  *stringEnd++ = ',';
+  *stringEnd++ = ' ';
+  stringEnd = appendDate(stringEnd);
+  *stringEnd++ = ',';
+  *stringEnd++ = ' ';
+  *appendDay(stringEnd, dayValue, n) = '\0';
+  return String(tempString);
+}
+
+//========================================================================//
+//the string functions read the RTC once and build the whole string in a
+//buffer from the time variables, so all the fields are from the same
+//second and only one String is allocated.
+
+char* ISL1208_RTC::appendNumber (char *buffer, uint16_t number) {
+  char digits[5];
+  byte digitCount = 0;
+
+  do {
+    digits[digitCount++] = '0' + (number % 10);
+    number /= 10;
+  } while (number > 0);
+
+  while (digitCount > 0) {
+    *buffer++ = digits[--digitCount];
+  }
+
+  return buffer;
+}
+
+//========================================================================//
+
+char* ISL1208_RTC::appendTime (char *buffer) {
+  buffer = appendNumber(buffer, hourValue);
+  *buffer++ = ':';
+  buffer = appendNumber(buffer, minuteValue);
+  *buffer++ = ':';
+  buffer = appendNumber(buffer, secondValue);
+
+  if (!isMilMode) { //no period in 24 hour mode
+    *buffer++ = ' ';
+    *buffer++ = (periodValue == 0) ? 'A' : 'P';
+    *buffer++ = 'M';
+  }
+
+  return buffer;
+}
+
+//========================================================================//
+
+char* ISL1208_RTC::appendDate (char *buffer) {
+  buffer = appendNumber(buffer, dateValue);
+  *buffer++ = '-';
+  buffer = appendNumber(buffer, monthValue);
+  *buffer++ = '-';
+  return appendNumber(buffer, yearValue + 2000);
+}
+
+//========================================================================//
+//a negative n is taken as a large number, which gives the full name, the
+//same as String::remove() did.
+
+char* ISL1208_RTC::appendDay (char *buffer, byte day, unsigned int n) {
+  const char *dayName = dayNamesArray[(startOfTheWeek + day) % 7];
+
+  while ((*dayName != '\0') && (n-- > 0)) {
+    *buffer++ = *dayName++;
+  }
+
+  return buffer;
 }
 
 //========================================================================//
@@ -713,14 +1620,16 @@ bool ISL1208_RTC::printTime() {
     Serial.print(minuteValue);
     Serial.print(':');
     Serial.print(secondValue);
-    Serial.print(' ');
 
-    if (periodValue == 0) {
-      Serial.print(F("AM, "));
+    if (isMilMode) { //no period in 24 hour mode
+      Serial.print(F(", "));
+    }
+    else if (periodValue == 0) {
+      Serial.print(F(" AM, "));
     }
     else {
       periodValue = 1;
-      Serial.print(F("PM, "));
+      Serial.print(F(" PM, "));
     }
 
     Serial.print(dateValue);
@@ -753,13 +1662,15 @@ bool ISL1208_RTC::printAlarmTime() {
     Serial.print(minuteValueAlarm);
     Serial.print(':');
     Serial.print(secondValueAlarm);
-    Serial.print(' ');
 
-    if (periodValueAlarm == 0) { //check HR21 bit (AM/PM)
-      Serial.print(F("AM, "));
+    if (isMilMode) { //no period in 24 hour mode
+      Serial.print(F(", "));
+    }
+    else if (periodValueAlarm == 0) { //check HR21 bit (AM/PM)
+      Serial.print(F(" AM, "));
     }
     else {
-      Serial.print(F("PM, "));
+      Serial.print(F(" PM, "));
     }
 
     Serial.print(dateValueAlarm);
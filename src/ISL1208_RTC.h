@@ -14,13 +14,15 @@
 //  Initial release: IST 11:49:42 AM, 27-05-2018, Sunday
 //  License: MIT
 //
-//  File last modified: +05:30 22:05:27 PM 09-12-2021, Thursday
+//  File last modified: +05:30 10:07:52 PM 19-10-2026, Monday
 //
 //========================================================================//
 
 #include <stdint.h>
 #include <Arduino.h>
 #include <Wire.h>
+#include "ISL1208_Calendar.h"
+#include "ISL1208_TimeZone.h"
 
 #define ISL1208_RTC_DEBUG //uncomment this line to enable debug info
 
@@ -56,10 +58,46 @@
 #define ISL1208_USR1    0x12  //user memory 1
 #define ISL1208_USR2    0x13  //user memory 2
 
+//register bits
+
+#define ISL1208_SR_ARST     B10000000  //auto reset enable bit of status register
+#define ISL1208_SR_XTOSCB   B01000000  //crystal oscillator enable bit of status register
+#define ISL1208_SR_WRTC     B00010000  //write RTC enable bit of status register
+#define ISL1208_SR_ALM      B00000100  //alarm bit of status register
+#define ISL1208_SR_BAT      B00000010  //battery bit of status register
+#define ISL1208_SR_RTCF     B00000001  //RTC fail bit of status register
+#define ISL1208_INT_IM      B10000000  //interrupt mode bit of interrupt register (1 = repeating pulse)
+#define ISL1208_INT_ALME    B01000000  //alarm enable bit of interrupt register
+#define ISL1208_INT_LPMODE  B00100000  //low power mode bit of interrupt register
+#define ISL1208_INT_FOBATB  B00010000  //frequency output on battery disable bit of interrupt register
+
+//========================================================================//
+//bus error codes. the last error can be read with getLastError().
+
+#define ISL1208_ERROR_NONE          0  //no error
+#define ISL1208_ERROR_DATA_LENGTH   1  //data too long for the transmit buffer
+#define ISL1208_ERROR_ADDRESS_NACK  2  //NACK received on transmitting the address
+#define ISL1208_ERROR_DATA_NACK     3  //NACK received on transmitting data
+#define ISL1208_ERROR_BUS           4  //other bus error
+#define ISL1208_ERROR_TIMEOUT       5  //bus operation timed out
+#define ISL1208_ERROR_SHORT_READ    6  //RTC returned fewer bytes than requested
+#define ISL1208_ERROR_INVALID_DATA  7  //input values are out of range
+
+//default bus settings. can be changed at runtime.
+
+#define ISL1208_BUS_TIMEOUT   25  //per-call timeout in milliseconds, including retries
+#define ISL1208_BUS_RETRIES   3   //number of retries after a failed transfer
+#define ISL1208_BUS_BACKOFF   1   //initial retry delay in milliseconds, doubled after each retry
+
+#define ISL1208_STRING_SIZE   40  //buffer size of the longest time, date and day string
+
 //========================================================================//
 //main class
 
 class ISL1208_RTC {
+  friend class ISL1208_DutyCycle; //uses the register functions directly
+  friend class ISL1208_Redundant;
+
   public:
     //all the following byte variables store in DEC format. The BCD conversion is carried out by the functions
     byte yearValue, monthValue, dateValue, dayValue, hourValue, minuteValue, secondValue, periodValue;
@@ -67,15 +105,27 @@ class ISL1208_RTC {
     byte startOfTheWeek;
     byte tempByte;
 
-    ISL1208_RTC(); //constructor
-    void begin(); //initializer
+    ISL1208_RTC(); //constructor. uses the default Wire bus
+    ISL1208_RTC (TwoWire&); //constructor for an RTC on another I2C bus
+    void begin(); //initializer. takes the 12/24 hour format from the RTC
     bool isRtcActive(); //checks if the RTC is available on the I2C bus
+    void setBusTimeout (uint16_t); //sets the per-call timeout in milliseconds
+    void setBusRetries (byte); //sets the number of retries after a failed transfer
+    void setBusPins (int, int); //sets the SDA and SCL pins used for bus recovery
+    bool recoverBus(); //releases a stuck bus by clocking SCL 9 times and sending a STOP
+    byte getLastError(); //returns the error code of the last bus operation
+    unsigned long getLastLatency(); //returns the duration of the last call that used the bus in microseconds
+    unsigned long getMaxLatency(); //returns the longest duration of a call that used the bus in microseconds
     bool updateTime(); //updates time registers from variables
     bool setTime (String); //updates time registers from a formatted time string
+    bool setTime (const char*); //same as above, but without String copies
     bool updateAlarmTime(); //updates alarm registers from variables
     bool setAlarmTime (String); //updates alarm registers from a formatted alarm time string
+    bool setAlarmTime (const char*); //same as above, but without String copies
     bool fetchTime(); //reads RTC time and alarm registers and updates the variables
-    int getHour(); //returns the 12 format hour in DEC
+    bool set24HourMode (bool); //selects 24 hour (true) or 12 hour (false) format and converts the RTC registers
+    bool is24HourMode(); //returns true in 24 hour mode
+    int getHour(); //returns the hour in DEC (1 to 12, or 0 to 23 in 24 hour mode)
     int getMinute(); //returns minutes in DEC
     int getSecond(); //returns seconds value
     int getPeriod(); //returns time period. 0 = AM, 1 = PM
@@ -90,8 +140,26 @@ class ISL1208_RTC {
     int getAlarmDate();
     int getAlarmDay();
     int getAlarmMonth();
+    int getStatus(); //returns the status register value, or -1 if the read fails
+    int getUserMemory (byte); //returns user memory byte 0 (USR1) or 1 (USR2), or -1 if the read fails
+    bool setUserMemory (byte, byte); //writes a user memory byte
+    bool modifyUserMemory (byte, byte, byte); //clears and sets bits of a user memory byte
+    bool getUserWord (uint16_t&); //reads both user memory bytes as a 16-bit value
+    bool setUserWord (uint16_t); //writes both user memory bytes in one transfer
+    bool modifyUserWord (uint16_t, uint16_t); //clears and sets bits of the 16-bit user memory
+    uint32_t getEpoch(); //reads the RTC and returns UTC seconds since 2000-01-01 00:00:00, or 0 if the read fails or the time is invalid
+    bool getEpoch (uint32_t&); //same as above. returns false if the read fails or the time is invalid
+    bool setEpoch (uint32_t); //writes UTC seconds since 2000-01-01 00:00:00 to the RTC
+    uint32_t toEpoch(); //converts the saved time values to UTC seconds since 2000-01-01 00:00:00, or ISL1208_EPOCH_INVALID
+    bool fromEpoch (uint32_t); //sets the time variables from UTC seconds since 2000-01-01 00:00:00. returns false after 2099
+    bool getDateTime (ISL1208_DateTime&); //reads the RTC and saves the time to a 24 hour snapshot
+    bool setDateTime (const ISL1208_DateTime&); //writes the time from a 24 hour snapshot to the RTC
+    void toDateTime (ISL1208_DateTime&); //converts the time variables to a snapshot
+    void fromDateTime (const ISL1208_DateTime&); //sets the time variables from a snapshot
+    void setTimeZone (ISL1208_TimeZone*); //converts the RTC time to local time with a time zone. NULL for none
     
-    String getTimeString(); //returns formatted time string (hh:mm:ss pp)
+    static const char* getDayName (byte); //returns the full name of a day (0 = Sunday to 6 = Saturday)
+    String getTimeString(); //returns formatted time string (hh:mm:ss pp, or hh:mm:ss in 24 hour mode)
     String getDateString(); //returns formatted date string (DD-MM-YYYY)
     String getDayString(); //returns the full name of day
     String getDayString (int); //returns the first n chars of day string (n = 1 to 9)
@@ -109,7 +177,56 @@ class ISL1208_RTC {
     byte decToBcd (byte); //converts a DEC value to BCD
 
     private:
-      String dayNamesArray[7] = {"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"};
+      class BusCall { //times a call from start to end. nested calls share the deadline of the outer call
+        public:
+          BusCall (ISL1208_RTC&);
+          ~BusCall();
+
+        private:
+          ISL1208_RTC &rtc;
+      };
+
+      TwoWire *wireBus; //I2C bus of this RTC
+      byte lastError;
+      uint16_t busTimeout;
+      byte busRetries;
+      int sdaPin, sclPin;
+      unsigned long lastLatency, maxLatency;
+      unsigned long callStartTime; //start of the outermost call
+      byte callDepth;
+      ISL1208_TimeZone *timeZone;
+      bool isMilMode; //24 hour format
+      byte clearedStatus; //ALM and BAT cleared on the RTC by a status read with ARST set
+
+      bool writeRegisters (byte, const byte*, byte); //writes to consecutive registers with retries
+      bool readRegisters (byte, byte*, byte); //reads consecutive registers with retries
+      byte writeOnce (byte, const byte*, byte); //single write attempt. returns the error code
+      byte readOnce (byte, byte*, byte); //single read attempt. returns the error code
+      bool isCallExpired(); //checks if the timeout of the current call has expired
+      bool retryTransfer (byte); //waits before the next retry. returns false if no retry is left
+      void recordLatency (unsigned long); //saves the duration of a call
+      void saveStatus (byte); //keeps the ALM and BAT flags that a status read cleared
+      bool isTimeValid(); //checks the ranges of the time variables
+      byte calculateDay(); //calculates the day value from the date
+      bool encodeTime (byte*); //converts the time variables to the time register values. returns false if out of range in UTC
+      void encodeDateTime (const ISL1208_DateTime&, byte*); //converts a snapshot to the time register values
+      void decodeDateTime (const byte*, ISL1208_DateTime&); //converts the time register values to a snapshot
+      bool readTime (ISL1208_DateTime&); //reads the RTC time to a snapshot without a time zone and checks it
+      bool encodeAlarmTime (byte*); //converts the alarm variables to the alarm register values
+      void encodeAlarm (const ISL1208_DateTime&, byte*); //converts a snapshot to the alarm register values
+      bool setAlarmYear (ISL1208_DateTime&, const ISL1208_DateTime&); //sets the year of the next alarm match
+      byte encodeHour (byte); //converts a 24 hour value to the hour register format
+      byte encodeHour (byte, bool); //converts a 24 hour value to the hour register format of the given mode
+      byte decodeHour (byte, bool); //converts an hour register value to 24 hour format
+      byte getHour24 (byte, byte); //returns the 24 hour value of an hour variable and period
+      void splitHour (byte, byte&, byte&); //sets an hour variable and period from a 24 hour value
+      bool isHourValid (byte); //checks the hour range of the current mode
+      byte charsToDec (const char*, byte); //converts n decimal digits to a number. returns 0xFF for non-digits
+      char* appendNumber (char*, uint16_t); //writes a number without leading zeros. returns the end of the string
+      char* appendTime (char*); //writes the time variables as in getTimeString()
+      char* appendDate (char*); //writes the date variables as in getDateString()
+      char* appendDay (char*, byte, unsigned int); //writes the first n chars of the name of a day value
+      static const char *const dayNamesArray[7]; //shared by all the objects, so no RAM is used per object
 };
 
 //========================================================================//
@@ -0,0 +1,257 @@
+
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  ISL1208 is an RTC from Intersil. This is an Arduino compatible
+//  library for ISL1208.
+//
+//  Filename: ISL1208_Redundant.cpp
+//  Description: Part of ISL1208 RTC library.
+//  Library version: 1.4.7
+//  Author: Vishnu Mohanan (@vishnumaiea)
+//  Source: https://github.com/vishnumaiea/ISL1208-RTC-Library
+//  Initial release: IST 11:49:42 AM, 27-05-2018, Sunday
+//  License: MIT
+//
+//  File last modified: +05:30 10:36:45 PM 19-10-2026, Monday
+//
+//========================================================================//
+
+#include "ISL1208_Redundant.h"
+
+//========================================================================//
+//constructor. the list must stay valid while the group is used. the first
+//RTC in the list is active until the first update.
+
+ISL1208_Redundant::ISL1208_Redundant (ISL1208_RTC **rtcs, byte count, uint16_t window) {
+  rtcList = rtcs;
+  rtcCount = (count < ISL1208_REDUNDANT_MAX) ? count : ISL1208_REDUNDANT_MAX;
+  plausibleWindow = window;
+  isAutoResync = true;
+  activeIndex = 0;
+  votedTime = 0;
+  failoverCount = 0;
+  resyncCount = 0;
+
+  for (byte i = 0; i < ISL1208_REDUNDANT_MAX; i++) {
+    healthList[i] = ISL1208_HEALTH_ABSENT;
+  }
+}
+
+//========================================================================//
+//each RTC gets one vote for every RTC it agrees with, including itself.
+//the RTC with the most votes is used. an RTC that is absent, failed or
+//invalid doesn't vote. the RTCs are only resynced if more than half of the
+//voting RTCs agree on the time. otherwise, such as two RTCs that disagree,
+//there's no way to tell which one is right, so all the voting RTCs are
+//reported as deviated and none of them is written.
+
+bool ISL1208_Redundant::update() {
+  uint32_t rtcTimes[ISL1208_REDUNDANT_MAX];
+  byte statusValues[ISL1208_REDUNDANT_MAX];
+  byte bestIndex = ISL1208_RTC_NONE;
+  byte bestVotes = 0;
+  byte okCount = 0; //voting RTCs
+
+  for (byte i = 0; i < rtcCount; i++) {
+    healthList[i] = readRtc(i, rtcTimes[i], statusValues[i]);
+  }
+
+  for (byte i = 0; i < rtcCount; i++) {
+    if (healthList[i] != ISL1208_HEALTH_OK) {
+      continue;
+    }
+
+    okCount++;
+    byte votes = 0;
+
+    for (byte j = 0; j < rtcCount; j++) {
+      if ((healthList[j] == ISL1208_HEALTH_OK) && isPlausible(rtcTimes[i], rtcTimes[j])) {
+        votes++;
+      }
+    }
+
+    if ((votes > bestVotes) || ((votes == bestVotes) && (i == activeIndex))) { //the active RTC wins a tie
+      bestVotes = votes;
+      bestIndex = i;
+    }
+  }
+
+  if (bestIndex == ISL1208_RTC_NONE) {
+    activeIndex = ISL1208_RTC_NONE;
+
+    #ifdef ISL1208_RTC_DEBUG
+      Serial.println(F("No RTC has a valid time."));
+    #endif
+
+    return false;
+  }
+
+  if ((activeIndex != ISL1208_RTC_NONE) && (activeIndex != bestIndex)) {
+    failoverCount++;
+
+    #ifdef ISL1208_RTC_DEBUG
+      Serial.print(F("RTC failover to "));
+      Serial.println(bestIndex);
+    #endif
+  }
+
+  activeIndex = bestIndex;
+  votedTime = rtcTimes[bestIndex];
+  bool isMajority = (bestVotes * 2) > okCount;
+
+  for (byte i = 0; i < rtcCount; i++) {
+    if ((healthList[i] == ISL1208_HEALTH_OK) && (!isMajority || !isPlausible(rtcTimes[i], votedTime))) {
+      healthList[i] = ISL1208_HEALTH_DEVIATED;
+    }
+
+    if (isAutoResync && isMajority && (healthList[i] != ISL1208_HEALTH_OK) && (healthList[i] != ISL1208_HEALTH_ABSENT)) {
+      if (resyncRtc(i, statusValues[i])) {
+        resyncCount++;
+      }
+    }
+  }
+
+  return true;
+}
+
+//========================================================================//
+
+bool ISL1208_Redundant::getDateTime (ISL1208_DateTime &dateTime) {
+  if (!update()) {
+    return false;
+  }
+
+  ISL1208_Calendar::fromEpoch(votedTime, dateTime);
+
+  if (rtcList[activeIndex]->timeZone != NULL) { //the RTCs keep UTC
+    return rtcList[activeIndex]->timeZone->toLocal(dateTime);
+  }
+
+  return true;
+}
+
+//========================================================================//
+
+uint32_t ISL1208_Redundant::getEpoch() {
+  if (!update()) {
+    return 0;
+  }
+
+  return votedTime; //the RTCs keep UTC
+}
+
+//========================================================================//
+//all the RTCs are written even if one fails.
+
+bool ISL1208_Redundant::setDateTime (const ISL1208_DateTime &dateTime) {
+  bool isWritten = true;
+
+  for (byte i = 0; i < rtcCount; i++) {
+    if (!rtcList[i]->setDateTime(dateTime)) {
+      isWritten = false;
+    }
+  }
+
+  return isWritten;
+}
+
+//========================================================================//
+
+void ISL1208_Redundant::setAutoResync (bool isEnabled) {
+  isAutoResync = isEnabled;
+}
+
+//========================================================================//
+
+byte ISL1208_Redundant::getActive() {
+  return activeIndex;
+}
+
+//========================================================================//
+
+byte ISL1208_Redundant::getHealth (byte index) {
+  if (index >= rtcCount) {
+    return ISL1208_HEALTH_ABSENT;
+  }
+
+  return healthList[index];
+}
+
+//========================================================================//
+
+unsigned long ISL1208_Redundant::getFailoverCount() {
+  return failoverCount;
+}
+
+//========================================================================//
+
+unsigned long ISL1208_Redundant::getResyncCount() {
+  return resyncCount;
+}
+
+//========================================================================//
+//the time registers and the status register are next to each other, so
+//both are read in one transfer. there's no separate presence check, since a
+//failed read already means the RTC is absent. the time is not converted to
+//local time.
+
+byte ISL1208_Redundant::readRtc (byte index, uint32_t &rtcTime, byte &statusValue) {
+  ISL1208_RTC &rtc = *rtcList[index];
+  byte timeData[8]; //seconds register to status register
+  ISL1208_DateTime dateTime;
+
+  if (!rtc.readRegisters(ISL1208_SC, timeData, 8)) {
+    return ISL1208_HEALTH_ABSENT;
+  }
+
+  statusValue = timeData[7];
+  rtc.saveStatus(statusValue); //the read clears ALM and BAT if ARST is set
+
+  if (statusValue & (ISL1208_SR_RTCF | ISL1208_SR_BAT)) {
+    return ISL1208_HEALTH_FAILED;
+  }
+
+  rtc.decodeDateTime(timeData, dateTime);
+
+  if (!ISL1208_Calendar::isValid(dateTime)) {
+    return ISL1208_HEALTH_INVALID;
+  }
+
+  rtcTime = ISL1208_Calendar::toEpoch(dateTime);
+  return ISL1208_HEALTH_OK;
+}
+
+//========================================================================//
+//WRTC is set first, because it is cleared after a total power failure and
+//the time can't be written without it. BAT is cleared and the alarm flag
+//and auto reset bit are kept. writing the time clears RTCF.
+
+bool ISL1208_Redundant::resyncRtc (byte index, byte statusValue) {
+  ISL1208_RTC &rtc = *rtcList[index];
+  ISL1208_RTC::BusCall busCall(rtc); //one timeout for both writes
+  ISL1208_DateTime dateTime;
+  byte timeData[7];
+
+  statusValue = (statusValue & (ISL1208_SR_ARST | ISL1208_SR_ALM)) | ISL1208_SR_WRTC;
+  ISL1208_Calendar::fromEpoch(votedTime, dateTime);
+
+  rtc.encodeDateTime(dateTime, timeData);
+
+  #ifdef ISL1208_RTC_DEBUG
+    Serial.print(F("Resyncing RTC "));
+    Serial.println(index);
+  #endif
+
+  return rtc.writeRegisters(ISL1208_SR, &statusValue, 1) && rtc.writeRegisters(ISL1208_SC, timeData, 7);
+}
+
+//========================================================================//
+
+bool ISL1208_Redundant::isPlausible (uint32_t firstTime, uint32_t secondTime) {
+  uint32_t difference = (firstTime > secondTime) ? (firstTime - secondTime) : (secondTime - firstTime);
+  return (difference <= plausibleWindow);
+}
+
+//========================================================================//
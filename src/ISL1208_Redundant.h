@@ -0,0 +1,80 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  ISL1208 is an RTC from Intersil. This is an Arduino compatible
+//  library for ISL1208.
+//
+//  Filename: ISL1208_Redundant.h
+//  Description: Header file for the redundant RTC group of ISL1208_RTC.
+//  Library version: 1.4.7
+//  Author: Vishnu Mohanan (@vishnumaiea)
+//  Source: https://github.com/vishnumaiea/ISL1208-RTC-Library
+//  Initial release: IST 11:49:42 AM, 27-05-2018, Sunday
+//  License: MIT
+//
+//  File last modified: +05:30 10:36:45 PM 19-10-2026, Monday
+//
+//========================================================================//
+
+#include "ISL1208_RTC.h"
+
+#ifndef _ISL1208_REDUNDANT_H_
+#define _ISL1208_REDUNDANT_H_
+
+//========================================================================//
+
+#define ISL1208_REDUNDANT_MAX     4  //max number of RTCs in a group
+#define ISL1208_REDUNDANT_WINDOW  2  //default max difference in seconds between RTCs that agree
+#define ISL1208_RTC_NONE          0xFF  //returned by getActive() if no RTC has a valid time
+
+//health of each RTC after the last update()
+
+#define ISL1208_HEALTH_OK         0  //the time agrees with the group
+#define ISL1208_HEALTH_ABSENT     1  //not found on the bus, or the read failed
+#define ISL1208_HEALTH_FAILED     2  //RTCF or BAT is set, so the time can't be trusted
+#define ISL1208_HEALTH_INVALID    3  //the time registers are out of range
+#define ISL1208_HEALTH_DEVIATED   4  //the time is outside the plausibility window
+
+//========================================================================//
+//a group of RTCs, usually on separate I2C buses, used as one clock. each
+//update reads the time and status of all the RTCs in one transfer per RTC
+//and votes. the time that most RTCs agree with, within the plausibility
+//window, is used. on a tie the active RTC is kept, so the group only fails
+//over when the active RTC drops out or is outvoted. RTCs that are on the
+//bus but deviate or have failed are resynced from the voted time, only if
+//more than half of the voting RTCs agree on it.
+//the RTCs must be started with begin() first.
+
+class ISL1208_Redundant {
+  public:
+    ISL1208_Redundant (ISL1208_RTC**, byte, uint16_t = ISL1208_REDUNDANT_WINDOW); //constructor
+    bool update(); //reads all the RTCs, votes and resyncs. returns false if no RTC has a valid time
+    bool getDateTime (ISL1208_DateTime&); //updates and returns the voted time, in local time if the active RTC has a time zone
+    uint32_t getEpoch(); //same as above in UTC seconds since 2000-01-01 00:00:00. returns 0 on failure
+    bool setDateTime (const ISL1208_DateTime&); //writes the time to all the RTCs. returns false if any write failed
+    void setAutoResync (bool); //enables or disables the resync of the deviating RTCs
+    byte getActive(); //returns the index of the RTC in use
+    byte getHealth (byte); //returns the ISL1208_HEALTH_* of an RTC
+    unsigned long getFailoverCount(); //returns the number of times the active RTC changed
+    unsigned long getResyncCount(); //returns the number of RTC resyncs
+
+  private:
+    ISL1208_RTC **rtcList;
+    byte rtcCount;
+    uint16_t plausibleWindow;
+    bool isAutoResync;
+    byte activeIndex;
+    uint32_t votedTime; //RTC time of the last update
+    byte healthList[ISL1208_REDUNDANT_MAX];
+    unsigned long failoverCount;
+    unsigned long resyncCount;
+
+    byte readRtc (byte, uint32_t&, byte&); //reads the time and status of an RTC in one transfer. returns the health
+    bool resyncRtc (byte, byte); //writes the voted time to an RTC
+    bool isPlausible (uint32_t, uint32_t); //checks if two times are within the window
+};
+
+//========================================================================//
+
+#endif //end _ISL1208_REDUNDANT_H_
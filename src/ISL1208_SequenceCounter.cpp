@@ -0,0 +1,111 @@
+
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  ISL1208 is an RTC from Intersil. This is an Arduino compatible
+//  library for ISL1208.
+//
+//  Filename: ISL1208_SequenceCounter.cpp
+//  Description: Part of ISL1208 RTC library.
+//  Library version: 1.4.7
+//  Author: Vishnu Mohanan (@vishnumaiea)
+//  Source: https://github.com/vishnumaiea/ISL1208-RTC-Library
+//  Initial release: IST 11:49:42 AM, 27-05-2018, Sunday
+//  License: MIT
+//
+//  File last modified: +05:30 08:47:09 PM 19-10-2026, Monday
+//
+//========================================================================//
+
+#include "ISL1208_SequenceCounter.h"
+
+//========================================================================//
+//constructor. an interval of 1 saves every value.
+
+ISL1208_SequenceCounter::ISL1208_SequenceCounter (ISL1208_RTC &rtcObject, uint16_t interval) : rtc(rtcObject) {
+  commitInterval = (interval > 0) ? interval : 1;
+  nextValue = 0;
+  savedLimit = 0;
+  isLoaded = false;
+}
+
+//========================================================================//
+//the counter starts from the saved limit. the first block of values is
+//reserved right away.
+//if RTCF is set, the RTC lost both the main and the battery power, and the
+//user memory no longer holds the limit. the counter is not loaded then,
+//because it would repeat values. the application has to write a safe start
+//value with setUserWord() and set the time, which clears RTCF.
+
+bool ISL1208_SequenceCounter::begin() {
+  uint16_t storedValue;
+  int statusValue = rtc.getStatus();
+
+  if ((statusValue < 0) || (statusValue & ISL1208_SR_RTCF)) {
+    return false;
+  }
+
+  if (!rtc.getUserWord(storedValue)) {
+    return false;
+  }
+
+  nextValue = storedValue;
+  savedLimit = storedValue;
+  isLoaded = true;
+  return true;
+}
+
+//========================================================================//
+//a new block is reserved in the user memory before a value past the saved
+//limit is handed out. returns false without changing the counter if the
+//write fails.
+
+bool ISL1208_SequenceCounter::next (uint16_t &value) {
+  if (!isLoaded && !begin()) {
+    return false;
+  }
+
+  if (nextValue == savedLimit) {
+    if (!rtc.setUserWord(savedLimit + commitInterval)) {
+      return false;
+    }
+
+    savedLimit += commitInterval;
+  }
+
+  value = nextValue++;
+  return true;
+}
+
+//========================================================================//
+//saves the next value instead of the limit, so no values are skipped on
+//the next power up. only the low byte (USR2) is written, because a single
+//byte can't be half written if the power fails. if the high byte would
+//also change, the saved limit is kept and the remaining values of the block
+//are skipped after power up.
+
+bool ISL1208_SequenceCounter::commit() {
+  if (!isLoaded) {
+    return false;
+  }
+
+  if ((nextValue == savedLimit) || ((nextValue >> 8) != (savedLimit >> 8))) {
+    return true;
+  }
+
+  if (!rtc.setUserMemory(1, byte(nextValue))) {
+    return false;
+  }
+
+  savedLimit = nextValue;
+  return true;
+}
+
+//========================================================================//
+
+uint16_t ISL1208_SequenceCounter::peek() {
+  return nextValue;
+}
+
+//========================================================================//
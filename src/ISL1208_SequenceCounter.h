@@ -0,0 +1,57 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  ISL1208 is an RTC from Intersil. This is an Arduino compatible
+//  library for ISL1208.
+//
+//  Filename: ISL1208_SequenceCounter.h
+//  Description: Header file for the persistent sequence counter of ISL1208_RTC.
+//  Library version: 1.4.7
+//  Author: Vishnu Mohanan (@vishnumaiea)
+//  Source: https://github.com/vishnumaiea/ISL1208-RTC-Library
+//  Initial release: IST 11:49:42 AM, 27-05-2018, Sunday
+//  License: MIT
+//
+//  File last modified: +05:30 08:47:09 PM 19-10-2026, Monday
+//
+//========================================================================//
+
+#include "ISL1208_RTC.h"
+
+#ifndef _ISL1208_SEQUENCECOUNTER_H_
+#define _ISL1208_SEQUENCECOUNTER_H_
+
+//========================================================================//
+
+#define ISL1208_COUNTER_INTERVAL  16  //default number of values handed out per user memory write
+
+//========================================================================//
+//a 16-bit counter that keeps increasing across power cycles, saved in the
+//battery backed user memory (USR1 and USR2). the memory holds a limit that
+//is always ahead of the values handed out. the limit is moved forward by
+//the commit interval only when it is reached, so most calls don't use the
+//bus. after a power loss the counter continues from the saved limit, so a
+//value is never repeated. up to one interval of values can be skipped,
+//unless commit() is called before the power goes off.
+//the counter wraps around after 65535.
+
+class ISL1208_SequenceCounter {
+  public:
+    ISL1208_SequenceCounter (ISL1208_RTC&, uint16_t = ISL1208_COUNTER_INTERVAL); //constructor
+    bool begin(); //loads the counter from the user memory. returns false after a total power loss (RTCF set)
+    bool next (uint16_t&); //returns the next value of the counter
+    bool commit(); //saves the exact counter value. call this from your power fail handling
+    uint16_t peek(); //returns the value the next call to next() will return
+
+  private:
+    ISL1208_RTC &rtc;
+    uint16_t commitInterval;
+    uint16_t nextValue; //next value to be handed out
+    uint16_t savedLimit; //value saved in the user memory
+    bool isLoaded;
+};
+
+//========================================================================//
+
+#endif //end _ISL1208_SEQUENCECOUNTER_H_
@@ -0,0 +1,347 @@
+
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  ISL1208 is an RTC from Intersil. This is an Arduino compatible
+//  library for ISL1208.
+//
+//  Filename: ISL1208_TimeZone.cpp
+//  Description: Part of ISL1208 RTC library.
+//  Library version: 1.4.7
+//  Author: Vishnu Mohanan (@vishnumaiea)
+//  Source: https://github.com/vishnumaiea/ISL1208-RTC-Library
+//  Initial release: IST 11:49:42 AM, 27-05-2018, Sunday
+//  License: MIT
+//
+//  File last modified: +05:30 08:02:36 PM 19-10-2026, Monday
+//
+//========================================================================//
+
+#include "ISL1208_TimeZone.h"
+
+//========================================================================//
+//constructor
+
+ISL1208_TimeZone::ISL1208_TimeZone() {
+  stdOffset = 0;
+  dstOffset = 0;
+  hasDst = false;
+  isCacheValid = false;
+}
+
+//========================================================================//
+//the format is std offset [dst [offset] [,start[/time],end[/time]]].
+//the POSIX offset is the time to add to the local time to get UTC, so
+//"EST5" means 5 hours behind UTC. the DST offset defaults to one hour ahead
+//of standard time. if the rules are not given, the US rules are used
+//(M3.2.0,M11.1.0). the rules are not changed if the string is invalid.
+
+bool ISL1208_TimeZone::begin (const char *tzString) {
+  const char *charPointer = tzString;
+  int32_t newStdOffset, newDstOffset;
+  ISL1208_TimeZoneRule newStartRule = {ISL1208_RULE_MONTH_WEEK, 3, 2, 0, 0, 7200};
+  ISL1208_TimeZoneRule newEndRule = {ISL1208_RULE_MONTH_WEEK, 11, 1, 0, 0, 7200};
+  bool newHasDst = false;
+
+  if (!parseName(charPointer) || !parseTime(charPointer, newStdOffset)) {
+    return false;
+  }
+
+  newStdOffset = -newStdOffset; //east is positive
+  newDstOffset = newStdOffset + 3600;
+
+  if (*charPointer != '\0') {
+    if (!parseName(charPointer)) {
+      return false;
+    }
+
+    newHasDst = true;
+
+    if ((*charPointer != ',') && (*charPointer != '\0')) {
+      if (!parseTime(charPointer, newDstOffset)) {
+        return false;
+      }
+
+      newDstOffset = -newDstOffset;
+    }
+
+    if (*charPointer == ',') {
+      charPointer++;
+
+      if (!parseRule(charPointer, newStartRule) || (*charPointer++ != ',') || !parseRule(charPointer, newEndRule)) {
+        return false;
+      }
+    }
+
+    if (*charPointer != '\0') {
+      return false;
+    }
+  }
+
+  stdOffset = newStdOffset;
+  dstOffset = newDstOffset;
+  hasDst = newHasDst;
+  startRule = newStartRule;
+  endRule = newEndRule;
+  isCacheValid = false;
+  return true;
+}
+
+//========================================================================//
+//returns ISL1208_EPOCH_INVALID if the time or the local time is not within
+//2000 to 2099.
+
+uint32_t ISL1208_TimeZone::toLocal (uint32_t utcTime) {
+  if (utcTime > ISL1208_EPOCH_MAX) {
+    return ISL1208_EPOCH_INVALID;
+  }
+
+  return addOffset(utcTime, getOffset(utcTime));
+}
+
+//========================================================================//
+//a local time in the hour repeated at the end of DST is taken as DST.
+//a local time in the hour skipped at the start of DST is taken as
+//standard time. returns ISL1208_EPOCH_INVALID if the time or the UTC time
+//is not within 2000 to 2099.
+
+uint32_t ISL1208_TimeZone::toUtc (uint32_t localTime) {
+  if (localTime > ISL1208_EPOCH_MAX) {
+    return ISL1208_EPOCH_INVALID;
+  }
+
+  uint32_t utcTime = addOffset(localTime, -stdOffset);
+
+  if (hasDst) {
+    uint32_t dstTime = addOffset(localTime, -dstOffset);
+
+    if ((dstTime != ISL1208_EPOCH_INVALID) && isDst(dstTime)) {
+      utcTime = dstTime;
+    }
+  }
+
+  return utcTime;
+}
+
+//========================================================================//
+//the snapshot is left unchanged if the conversion fails.
+
+bool ISL1208_TimeZone::toLocal (ISL1208_DateTime &dateTime) {
+  return ISL1208_Calendar::fromEpoch(toLocal(ISL1208_Calendar::toEpoch(dateTime)), dateTime);
+}
+
+//========================================================================//
+//the snapshot is left unchanged if the conversion fails.
+
+bool ISL1208_TimeZone::toUtc (ISL1208_DateTime &dateTime) {
+  return ISL1208_Calendar::fromEpoch(toUtc(ISL1208_Calendar::toEpoch(dateTime)), dateTime);
+}
+
+//========================================================================//
+
+uint32_t ISL1208_TimeZone::addOffset (uint32_t epochTime, int32_t offset) {
+  if (offset < 0) {
+    if (epochTime < (uint32_t) -offset) {
+      return ISL1208_EPOCH_INVALID;
+    }
+  }
+  else if ((uint32_t) offset > (ISL1208_EPOCH_MAX - epochTime)) {
+    return ISL1208_EPOCH_INVALID;
+  }
+
+  return epochTime + offset;
+}
+
+//========================================================================//
+//the DST changes are only calculated when the year changes.
+//in the southern hemisphere DST starts later in the year than it ends.
+
+bool ISL1208_TimeZone::isDst (uint32_t utcTime) {
+  if (!hasDst || (utcTime > ISL1208_EPOCH_MAX)) {
+    return false;
+  }
+
+  if (!isCacheValid || (utcTime < yearStart) || (utcTime >= yearEnd)) {
+    buildCache(utcTime);
+  }
+
+  if (dstStart < dstEnd) {
+    return ((utcTime >= dstStart) && (utcTime < dstEnd));
+  }
+
+  return ((utcTime >= dstStart) || (utcTime < dstEnd));
+}
+
+//========================================================================//
+
+int32_t ISL1208_TimeZone::getOffset (uint32_t utcTime) {
+  return isDst(utcTime) ? dstOffset : stdOffset;
+}
+
+//========================================================================//
+//the start rule is in standard time and the end rule is in DST.
+
+void ISL1208_TimeZone::buildCache (uint32_t utcTime) {
+  ISL1208_DateTime dateTime;
+  ISL1208_Calendar::fromEpoch(utcTime, dateTime);
+
+  yearStart = (uint32_t) ISL1208_Calendar::daysSince2000(dateTime.year, 1, 1) * 86400;
+
+  if (dateTime.year < 99) {
+    yearEnd = (uint32_t) ISL1208_Calendar::daysSince2000(dateTime.year + 1, 1, 1) * 86400;
+  }
+  else {
+    yearEnd = ISL1208_EPOCH_MAX + 1; //end of 2099
+  }
+
+  dstStart = ruleToEpoch(startRule, dateTime.year) - stdOffset;
+  dstEnd = ruleToEpoch(endRule, dateTime.year) - dstOffset;
+  isCacheValid = true;
+}
+
+//========================================================================//
+
+uint32_t ISL1208_TimeZone::ruleToEpoch (const ISL1208_TimeZoneRule &rule, byte year) {
+  uint16_t dayCount = ISL1208_Calendar::daysSince2000(year, 1, 1);
+
+  if (rule.type == ISL1208_RULE_JULIAN) {
+    dayCount += rule.day - 1;
+
+    if (ISL1208_Calendar::isLeapYear(year) && (rule.day >= 60)) { //skip February 29
+      dayCount++;
+    }
+  }
+  else if (rule.type == ISL1208_RULE_DAY) {
+    dayCount += rule.day;
+  }
+  else {
+    byte firstWeekday = ISL1208_Calendar::dayOfWeek(year, rule.month, 1);
+    byte date = 1 + ((rule.weekday + 7 - firstWeekday) % 7) + ((rule.week - 1) * 7);
+
+    if (date > ISL1208_Calendar::daysInMonth(year, rule.month)) { //week 5 means the last one
+      date -= 7;
+    }
+
+    dayCount = ISL1208_Calendar::daysSince2000(year, rule.month, date);
+  }
+
+  return ((uint32_t) dayCount * 86400) + rule.time;
+}
+
+//========================================================================//
+//a name is 3 or more letters, or any characters within < and >.
+
+bool ISL1208_TimeZone::parseName (const char *&charPointer) {
+  const char *nameStart = charPointer;
+
+  if (*charPointer == '<') {
+    while ((*charPointer != '\0') && (*charPointer != '>')) charPointer++;
+    if (*charPointer++ != '>') return false;
+    return ((charPointer - nameStart) >= 5);
+  }
+
+  while (((*charPointer >= 'A') && (*charPointer <= 'Z')) || ((*charPointer >= 'a') && (*charPointer <= 'z'))) {
+    charPointer++;
+  }
+
+  return ((charPointer - nameStart) >= 3);
+}
+
+//========================================================================//
+//parses [+|-]hh[:mm[:ss]] to seconds.
+
+bool ISL1208_TimeZone::parseTime (const char *&charPointer, int32_t &seconds) {
+  bool isNegative = false;
+  uint16_t hours, minutes = 0, secondsPart = 0;
+
+  if ((*charPointer == '+') || (*charPointer == '-')) {
+    isNegative = (*charPointer == '-');
+    charPointer++;
+  }
+
+  if (!parseNumber(charPointer, hours) || (hours > 167)) {
+    return false;
+  }
+
+  if (*charPointer == ':') {
+    charPointer++;
+
+    if (!parseNumber(charPointer, minutes) || (minutes > 59)) {
+      return false;
+    }
+
+    if (*charPointer == ':') {
+      charPointer++;
+
+      if (!parseNumber(charPointer, secondsPart) || (secondsPart > 59)) {
+        return false;
+      }
+    }
+  }
+
+  seconds = ((int32_t) hours * 3600) + ((int32_t) minutes * 60) + secondsPart;
+  if (isNegative) seconds = -seconds;
+  return true;
+}
+
+//========================================================================//
+
+bool ISL1208_TimeZone::parseNumber (const char *&charPointer, uint16_t &value) {
+  const char *numberStart = charPointer;
+  value = 0;
+
+  while ((*charPointer >= '0') && (*charPointer <= '9') && (value < 1000)) {
+    value = (value * 10) + (*charPointer++ - '0');
+  }
+
+  return (charPointer != numberStart);
+}
+
+//========================================================================//
+//parses Jn, n or Mm.w.d with an optional /time. the time defaults to 02:00:00.
+
+bool ISL1208_TimeZone::parseRule (const char *&charPointer, ISL1208_TimeZoneRule &rule) {
+  uint16_t month, week, weekday;
+
+  rule.time = 7200;
+
+  if (*charPointer == 'J') {
+    charPointer++;
+    rule.type = ISL1208_RULE_JULIAN;
+
+    if (!parseNumber(charPointer, rule.day) || (rule.day < 1) || (rule.day > 365)) {
+      return false;
+    }
+  }
+  else if (*charPointer == 'M') {
+    charPointer++;
+    rule.type = ISL1208_RULE_MONTH_WEEK;
+
+    if (!parseNumber(charPointer, month) || (month < 1) || (month > 12) || (*charPointer++ != '.') ||
+      !parseNumber(charPointer, week) || (week < 1) || (week > 5) || (*charPointer++ != '.') ||
+      !parseNumber(charPointer, weekday) || (weekday > 6)) {
+        return false;
+    }
+
+    rule.month = month;
+    rule.week = week;
+    rule.weekday = weekday;
+  }
+  else {
+    rule.type = ISL1208_RULE_DAY;
+
+    if (!parseNumber(charPointer, rule.day) || (rule.day > 365)) {
+      return false;
+    }
+  }
+
+  if (*charPointer == '/') {
+    charPointer++;
+    return parseTime(charPointer, rule.time);
+  }
+
+  return true;
+}
+
+//========================================================================//
@@ -0,0 +1,80 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  ISL1208 is an RTC from Intersil. This is an Arduino compatible
+//  library for ISL1208.
+//
+//  Filename: ISL1208_TimeZone.h
+//  Description: Header file for the time zone and DST rules of ISL1208_RTC.
+//  Library version: 1.4.7
+//  Author: Vishnu Mohanan (@vishnumaiea)
+//  Source: https://github.com/vishnumaiea/ISL1208-RTC-Library
+//  Initial release: IST 11:49:42 AM, 27-05-2018, Sunday
+//  License: MIT
+//
+//  File last modified: +05:30 08:02:36 PM 19-10-2026, Monday
+//
+//========================================================================//
+
+#include "ISL1208_Calendar.h"
+
+#ifndef _ISL1208_TIMEZONE_H_
+#define _ISL1208_TIMEZONE_H_
+
+//========================================================================//
+
+#define ISL1208_RULE_JULIAN       0  //Jn - day 1 to 365, February 29 is never counted
+#define ISL1208_RULE_DAY          1  //n - day 0 to 365, February 29 is counted
+#define ISL1208_RULE_MONTH_WEEK   2  //Mm.w.d - day d of week w of month m. week 5 is the last week
+
+//a DST start or end rule from the POSIX TZ string. the time is the local
+//time of the change in seconds from midnight.
+
+struct ISL1208_TimeZoneRule {
+  byte type;
+  byte month, week, weekday;
+  uint16_t day;
+  int32_t time;
+};
+
+//========================================================================//
+//converts UTC time to local time with the rules from a POSIX TZ string,
+//for example "IST-5:30" or "CET-1CEST,M3.5.0,M10.5.0/3".
+//the DST changes of a year are calculated once and cached, so a
+//conversion is only a few comparisons until the year changes.
+
+class ISL1208_TimeZone {
+  public:
+    ISL1208_TimeZone(); //constructor. the default time zone is UTC
+    bool begin (const char*); //sets the rules from a POSIX TZ string. returns false if the string is invalid
+    uint32_t toLocal (uint32_t); //converts UTC seconds since 2000 to local seconds since 2000, or ISL1208_EPOCH_INVALID
+    uint32_t toUtc (uint32_t); //converts local seconds since 2000 to UTC seconds since 2000, or ISL1208_EPOCH_INVALID
+    bool toLocal (ISL1208_DateTime&); //converts a UTC snapshot to local time. returns false if it is invalid or out of range
+    bool toUtc (ISL1208_DateTime&); //converts a local snapshot to UTC. returns false if it is invalid or out of range
+    bool isDst (uint32_t); //returns true if DST is in effect at a UTC time
+    int32_t getOffset (uint32_t); //returns the local time offset from UTC in seconds at a UTC time
+
+  private:
+    int32_t stdOffset; //standard time offset from UTC in seconds, east is positive
+    int32_t dstOffset; //DST offset from UTC in seconds
+    bool hasDst;
+    ISL1208_TimeZoneRule startRule, endRule;
+
+    //cache of the year of the last conversion
+    bool isCacheValid;
+    uint32_t yearStart, yearEnd; //UTC range of the cached year
+    uint32_t dstStart, dstEnd; //UTC time of the DST changes in the cached year
+
+    void buildCache (uint32_t); //calculates the DST changes of the year of a UTC time
+    uint32_t ruleToEpoch (const ISL1208_TimeZoneRule&, byte); //returns the local time of a rule in a year
+    static uint32_t addOffset (uint32_t, int32_t); //adds an offset. returns ISL1208_EPOCH_INVALID outside 2000 to 2099
+    bool parseName (const char*&);
+    bool parseTime (const char*&, int32_t&);
+    bool parseNumber (const char*&, uint16_t&);
+    bool parseRule (const char*&, ISL1208_TimeZoneRule&);
+};
+
+//========================================================================//
+
+#endif //end _ISL1208_TIMEZONE_H_
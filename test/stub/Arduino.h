@@ -0,0 +1,144 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  Host stub of the Arduino core, used to build the library on a PC for
+//  the tests and benchmarks. Only what the library uses is provided.
+//  The clock is virtual and only moves when delay(), delayMicroseconds()
+//  or a simulated bus transfer moves it.
+//
+//========================================================================//
+
+#ifndef _ARDUINO_STUB_H_
+#define _ARDUINO_STUB_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH          1
+#define LOW           0
+#define INPUT         0
+#define OUTPUT        1
+#define INPUT_PULLUP  2
+
+#define DEC 10
+#define HEX 16
+
+//only the binary constants used by the library
+
+#define B00000001 1
+#define B00000010 2
+#define B00000100 4
+#define B00010000 16
+#define B00011111 31
+#define B00100000 32
+#define B00111111 63
+#define B01000000 64
+#define B01111111 127
+#define B10000000 128
+
+class __FlashStringHelper;
+#define F(stringLiteral) (reinterpret_cast<const __FlashStringHelper*>(stringLiteral))
+
+//========================================================================//
+//same allocation behaviour as the Arduino String: the buffer is allocated
+//on the heap and grown when needed.
+
+class String {
+  public:
+    String (const char* = "");
+    String (const String&);
+    explicit String (char);
+    explicit String (int, unsigned char = DEC);
+    explicit String (unsigned int, unsigned char = DEC);
+    explicit String (long, unsigned char = DEC);
+    explicit String (unsigned long, unsigned char = DEC);
+    ~String();
+    String& operator= (const String&);
+    String& operator+= (const String&);
+    String& operator+= (const char*);
+    String& operator+= (char);
+    bool operator== (const char*) const;
+    unsigned int length() const;
+    const char* c_str() const;
+    void remove (unsigned int);
+
+  private:
+    char *buffer;
+    unsigned int bufferLength;
+    unsigned int capacity;
+
+    void append (const char*, unsigned int);
+};
+
+//========================================================================//
+
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write (uint8_t) = 0;
+    size_t write (const char*);
+    size_t print (const char*);
+    size_t print (const __FlashStringHelper*);
+    size_t print (const String&);
+    size_t print (char);
+    size_t print (unsigned char, int = DEC);
+    size_t print (int, int = DEC);
+    size_t print (unsigned int, int = DEC);
+    size_t print (long, int = DEC);
+    size_t print (unsigned long, int = DEC);
+    size_t println();
+    template <typename T> size_t println (const T &value) { return print(value) + println(); }
+    template <typename T> size_t println (const T &value, int base) { return print(value, base) + println(); }
+};
+
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    virtual void flush() {}
+};
+
+//========================================================================//
+//the serial port keeps the last output and plays back the given input.
+
+class HardwareSerial : public Stream {
+  public:
+    char output[4096];
+    size_t outputLength;
+
+    HardwareSerial();
+    void begin (unsigned long) {}
+    void setInput (const char*); //text to be read
+    void clearOutput();
+    size_t write (uint8_t) override;
+    using Print::write;
+    int available() override;
+    int read() override;
+    int peek() override;
+
+  private:
+    const char *input;
+};
+
+extern HardwareSerial Serial;
+
+//========================================================================//
+
+unsigned long millis();
+unsigned long micros();
+void delay (unsigned long);
+void delayMicroseconds (unsigned int);
+void pinMode (uint8_t, uint8_t);
+void digitalWrite (uint8_t, uint8_t);
+int digitalRead (uint8_t);
+
+void stubAdvanceMicros (unsigned long); //moves the virtual clock
+
+#endif //end _ARDUINO_STUB_H_
@@ -0,0 +1,65 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  Host stub of the Wire library with a simulated ISL1208 on each bus.
+//  Faults can be injected per bus: address NACKs, timeouts, short reads,
+//  an absent device and SDA held low until the bus is clocked free.
+//
+//========================================================================//
+
+#ifndef _WIRE_STUB_H_
+#define _WIRE_STUB_H_
+
+#include "Arduino.h"
+
+#define WIRE_HAS_TIMEOUT
+#define WIRE_BUFFER_LENGTH  32
+#define STUB_REGISTER_COUNT 0x14  //registers of the ISL1208
+
+class TwoWire : public Stream {
+  public:
+    byte registers[STUB_REGISTER_COUNT];
+    bool isPresent; //the device answers its address
+    bool isEnabled; //the I2C peripheral owns the pins
+    byte nackCount; //number of coming transfers NACKed on the address
+    byte timeoutCount; //number of coming transfers that time out
+    byte shortReadCount; //number of coming reads that return one byte less
+    byte stuckClocks; //SDA is held low until this many SCL clocks are sent on the pins
+    uint8_t sdaPin, sclPin;
+    unsigned long transferMicros; //virtual time taken by each transfer
+    unsigned long transferCount; //every endTransmission() and requestFrom()
+    unsigned long beginCount, endCount;
+    uint32_t wireTimeout;
+
+    TwoWire (uint8_t = 18, uint8_t = 19);
+    ~TwoWire();
+    void begin();
+    void end();
+    void setWireTimeout (uint32_t = 25000, bool = false);
+    void beginTransmission (uint8_t);
+    size_t write (uint8_t) override;
+    using Print::write;
+    uint8_t endTransmission (bool = true);
+    uint8_t requestFrom (uint8_t, uint8_t);
+    int available() override;
+    int read() override;
+    int peek() override;
+
+    static TwoWire *firstBus; //all the buses, for the pin functions
+    TwoWire *nextBus;
+
+  private:
+    byte txBuffer[WIRE_BUFFER_LENGTH];
+    byte txLength;
+    byte rxBuffer[WIRE_BUFFER_LENGTH];
+    byte rxLength, rxIndex;
+    byte registerPointer;
+
+    byte checkTransfer(); //returns the error of the coming transfer
+    void writeRegister (byte, byte);
+};
+
+extern TwoWire Wire;
+
+#endif //end _WIRE_STUB_H_
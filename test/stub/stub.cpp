@@ -0,0 +1,465 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  Host stub of the Arduino core and the Wire library.
+//
+//========================================================================//
+
+#include <stdio.h>
+#include "Arduino.h"
+#include "Wire.h"
+
+#define STUB_PIN_COUNT  64
+
+static unsigned long currentMicros = 0;
+static uint8_t pinModes[STUB_PIN_COUNT];
+static uint8_t pinLevels[STUB_PIN_COUNT];
+
+HardwareSerial Serial;
+TwoWire *TwoWire::firstBus = NULL;
+TwoWire Wire;
+
+//========================================================================//
+//String
+
+String::String (const char *value) : buffer(NULL), bufferLength(0), capacity(0) {
+  append(value, strlen(value));
+}
+
+String::String (const String &other) : buffer(NULL), bufferLength(0), capacity(0) {
+  append(other.c_str(), other.length());
+}
+
+String::String (char value) : buffer(NULL), bufferLength(0), capacity(0) {
+  append(&value, 1);
+}
+
+String::String (int value, unsigned char base) : buffer(NULL), bufferLength(0), capacity(0) {
+  char digits[36];
+  snprintf(digits, sizeof(digits), (base == HEX) ? "%x" : "%d", value);
+  append(digits, strlen(digits));
+}
+
+String::String (unsigned int value, unsigned char base) : buffer(NULL), bufferLength(0), capacity(0) {
+  char digits[36];
+  snprintf(digits, sizeof(digits), (base == HEX) ? "%x" : "%u", value);
+  append(digits, strlen(digits));
+}
+
+String::String (long value, unsigned char base) : buffer(NULL), bufferLength(0), capacity(0) {
+  char digits[36];
+  snprintf(digits, sizeof(digits), (base == HEX) ? "%lx" : "%ld", value);
+  append(digits, strlen(digits));
+}
+
+String::String (unsigned long value, unsigned char base) : buffer(NULL), bufferLength(0), capacity(0) {
+  char digits[36];
+  snprintf(digits, sizeof(digits), (base == HEX) ? "%lx" : "%lu", value);
+  append(digits, strlen(digits));
+}
+
+String::~String() {
+  delete[] buffer;
+}
+
+String& String::operator= (const String &other) {
+  if (this != &other) {
+    bufferLength = 0;
+    append(other.c_str(), other.length());
+  }
+
+  return *this;
+}
+
+String& String::operator+= (const String &other) {
+  append(other.c_str(), other.length());
+  return *this;
+}
+
+String& String::operator+= (const char *value) {
+  append(value, strlen(value));
+  return *this;
+}
+
+String& String::operator+= (char value) {
+  append(&value, 1);
+  return *this;
+}
+
+bool String::operator== (const char *value) const {
+  return (strcmp(c_str(), value) == 0);
+}
+
+unsigned int String::length() const {
+  return bufferLength;
+}
+
+const char* String::c_str() const {
+  return (buffer != NULL) ? buffer : "";
+}
+
+void String::remove (unsigned int index) {
+  if (index < bufferLength) {
+    bufferLength = index;
+    buffer[bufferLength] = '\0';
+  }
+}
+
+//the buffer grows to the exact size, the same as the Arduino String
+
+void String::append (const char *value, unsigned int valueLength) {
+  if ((buffer == NULL) || ((bufferLength + valueLength) > capacity)) {
+    char *newBuffer = new char[bufferLength + valueLength + 1];
+
+    if (buffer != NULL) {
+      memcpy(newBuffer, buffer, bufferLength);
+      delete[] buffer;
+    }
+
+    buffer = newBuffer;
+    capacity = bufferLength + valueLength;
+  }
+
+  memcpy(buffer + bufferLength, value, valueLength);
+  bufferLength += valueLength;
+  buffer[bufferLength] = '\0';
+}
+
+//========================================================================//
+//Print
+
+size_t Print::write (const char *text) {
+  size_t count = 0;
+  while (*text != '\0') count += write(uint8_t(*text++));
+  return count;
+}
+
+size_t Print::print (const char *text) {
+  return write(text);
+}
+
+size_t Print::print (const __FlashStringHelper *text) {
+  return write(reinterpret_cast<const char*>(text));
+}
+
+size_t Print::print (const String &text) {
+  return write(text.c_str());
+}
+
+size_t Print::print (char value) {
+  return write(uint8_t(value));
+}
+
+size_t Print::print (unsigned char value, int base) {
+  return print((unsigned long) value, base);
+}
+
+size_t Print::print (int value, int base) {
+  return print((long) value, base);
+}
+
+size_t Print::print (unsigned int value, int base) {
+  return print((unsigned long) value, base);
+}
+
+size_t Print::print (long value, int base) {
+  if ((base == DEC) && (value < 0)) {
+    return print('-') + print((unsigned long) -value, base);
+  }
+
+  return print((unsigned long) value, base);
+}
+
+size_t Print::print (unsigned long value, int base) {
+  char digits[36];
+  snprintf(digits, sizeof(digits), (base == HEX) ? "%lX" : "%lu", value);
+  return write(digits);
+}
+
+size_t Print::println() {
+  return write("\r\n");
+}
+
+//========================================================================//
+//serial port
+
+HardwareSerial::HardwareSerial() {
+  input = "";
+  clearOutput();
+}
+
+void HardwareSerial::setInput (const char *text) {
+  input = text;
+}
+
+void HardwareSerial::clearOutput() {
+  outputLength = 0;
+  output[0] = '\0';
+}
+
+size_t HardwareSerial::write (uint8_t value) {
+  if (outputLength < (sizeof(output) - 1)) { //the rest is dropped
+    output[outputLength++] = char(value);
+    output[outputLength] = '\0';
+  }
+
+  return 1;
+}
+
+int HardwareSerial::available() {
+  return strlen(input);
+}
+
+int HardwareSerial::read() {
+  return (*input != '\0') ? byte(*input++) : -1;
+}
+
+int HardwareSerial::peek() {
+  return (*input != '\0') ? byte(*input) : -1;
+}
+
+//========================================================================//
+//time and pins
+
+unsigned long millis() {
+  return currentMicros / 1000;
+}
+
+unsigned long micros() {
+  return currentMicros;
+}
+
+void delay (unsigned long duration) {
+  currentMicros += duration * 1000;
+}
+
+void delayMicroseconds (unsigned int duration) {
+  currentMicros += duration;
+}
+
+void stubAdvanceMicros (unsigned long duration) {
+  currentMicros += duration;
+}
+
+//a pin is only driven by the sketch if the I2C peripheral doesn't own it
+
+static TwoWire* findBus (uint8_t pin) {
+  for (TwoWire *bus = TwoWire::firstBus; bus != NULL; bus = bus->nextBus) {
+    if ((bus->sdaPin == pin) || (bus->sclPin == pin)) return bus;
+  }
+
+  return NULL;
+}
+
+void pinMode (uint8_t pin, uint8_t mode) {
+  TwoWire *bus = findBus(pin);
+
+  if ((pin >= STUB_PIN_COUNT) || ((bus != NULL) && bus->isEnabled)) {
+    return;
+  }
+
+  //releasing SCL after it was pulled low is one clock
+  if ((bus != NULL) && (pin == bus->sclPin) && (pinModes[pin] == OUTPUT) && (pinLevels[pin] == LOW) &&
+    (mode != OUTPUT) && (bus->stuckClocks > 0)) {
+      bus->stuckClocks--;
+  }
+
+  pinModes[pin] = mode;
+}
+
+void digitalWrite (uint8_t pin, uint8_t level) {
+  TwoWire *bus = findBus(pin);
+
+  if ((pin < STUB_PIN_COUNT) && ((bus == NULL) || !bus->isEnabled)) {
+    pinLevels[pin] = level;
+  }
+}
+
+int digitalRead (uint8_t pin) {
+  TwoWire *bus = findBus(pin);
+
+  if (pin >= STUB_PIN_COUNT) {
+    return LOW;
+  }
+
+  if ((bus != NULL) && (pin == bus->sdaPin) && (bus->stuckClocks > 0)) {
+    return LOW;
+  }
+
+  if ((pinModes[pin] == OUTPUT) && ((bus == NULL) || !bus->isEnabled)) {
+    return pinLevels[pin];
+  }
+
+  return HIGH; //pulled up
+}
+
+//========================================================================//
+//Wire. the simulated RTC starts with RTCF set and WRTC cleared, the same as
+//after the first power up.
+
+TwoWire::TwoWire (uint8_t sda, uint8_t scl) {
+  memset(registers, 0, sizeof(registers));
+  registers[0x07] = B00000001; //RTCF
+  isPresent = true;
+  isEnabled = false;
+  nackCount = 0;
+  timeoutCount = 0;
+  shortReadCount = 0;
+  stuckClocks = 0;
+  sdaPin = sda;
+  sclPin = scl;
+  transferMicros = 200;
+  transferCount = 0;
+  beginCount = 0;
+  endCount = 0;
+  wireTimeout = 0;
+  txLength = 0;
+  rxLength = 0;
+  rxIndex = 0;
+  registerPointer = 0;
+  nextBus = firstBus;
+  firstBus = this;
+}
+
+TwoWire::~TwoWire() {
+  for (TwoWire **bus = &firstBus; *bus != NULL; bus = &(*bus)->nextBus) {
+    if (*bus == this) {
+      *bus = nextBus;
+      break;
+    }
+  }
+}
+
+void TwoWire::begin() {
+  isEnabled = true;
+  beginCount++;
+}
+
+void TwoWire::end() {
+  isEnabled = false;
+  endCount++;
+}
+
+void TwoWire::setWireTimeout (uint32_t timeout, bool) {
+  wireTimeout = timeout;
+}
+
+void TwoWire::beginTransmission (uint8_t) {
+  txLength = 0;
+}
+
+size_t TwoWire::write (uint8_t value) {
+  if (txLength >= WIRE_BUFFER_LENGTH) {
+    return 0;
+  }
+
+  txBuffer[txLength++] = value;
+  return 1;
+}
+
+//the data is only applied if the whole transfer succeeds
+
+uint8_t TwoWire::endTransmission (bool) {
+  byte error = checkTransfer();
+
+  if (error != 0) {
+    return error;
+  }
+
+  if (txLength > 0) {
+    registerPointer = txBuffer[0] % STUB_REGISTER_COUNT;
+  }
+
+  for (byte i = 1; i < txLength; i++) {
+    writeRegister(registerPointer, txBuffer[i]);
+    registerPointer = (registerPointer + 1) % STUB_REGISTER_COUNT;
+  }
+
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom (uint8_t, uint8_t quantity) {
+  rxLength = 0;
+  rxIndex = 0;
+
+  if (checkTransfer() != 0) {
+    return 0;
+  }
+
+  if (quantity > WIRE_BUFFER_LENGTH) quantity = WIRE_BUFFER_LENGTH;
+
+  if ((shortReadCount > 0) && (quantity > 0)) {
+    shortReadCount--;
+    quantity--;
+  }
+
+  bool isStatusRead = false;
+
+  for (byte i = 0; i < quantity; i++) {
+    if (registerPointer == 0x07) isStatusRead = true;
+    rxBuffer[rxLength++] = registers[registerPointer];
+    registerPointer = (registerPointer + 1) % STUB_REGISTER_COUNT;
+  }
+
+  //with ARST set, ALM and BAT are cleared after the status register is read
+  if (isStatusRead && (registers[0x07] & B10000000)) {
+    registers[0x07] &= ~0x06;
+  }
+
+  return rxLength;
+}
+
+int TwoWire::available() {
+  return rxLength - rxIndex;
+}
+
+int TwoWire::read() {
+  return (rxIndex < rxLength) ? rxBuffer[rxIndex++] : -1;
+}
+
+int TwoWire::peek() {
+  return (rxIndex < rxLength) ? rxBuffer[rxIndex] : -1;
+}
+
+//the error codes are the same as the AVR Wire library
+
+byte TwoWire::checkTransfer() {
+  transferCount++;
+  stubAdvanceMicros(transferMicros);
+
+  if (!isEnabled) return 4;
+  if (stuckClocks > 0) return 5;
+
+  if (timeoutCount > 0) {
+    timeoutCount--;
+    return 5;
+  }
+
+  if (!isPresent) return 2;
+
+  if (nackCount > 0) {
+    nackCount--;
+    return 2;
+  }
+
+  return 0;
+}
+
+//the time registers can only be written when WRTC is set, and writing them
+//clears RTCF. ALM and BAT can only be cleared. RTCF is read only.
+
+void TwoWire::writeRegister (byte address, byte value) {
+  if (address <= 0x06) {
+    if (registers[0x07] & B00010000) {
+      registers[address] = value;
+      registers[0x07] &= ~B00000001;
+    }
+  }
+  else if (address == 0x07) {
+    registers[0x07] = (value & 0xD0) | (registers[0x07] & value & 0x06) | (registers[0x07] & B00000001);
+  }
+  else {
+    registers[address] = value;
+  }
+}
@@ -0,0 +1,54 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  Minimal test helpers for the host tests. Each test file is a program
+//  that returns non-zero if any check failed.
+//
+//========================================================================//
+
+#ifndef _ISL1208_TEST_H_
+#define _ISL1208_TEST_H_
+
+#include <stdio.h>
+#include "Arduino.h"
+#include "Wire.h"
+
+static int testFailures = 0;
+
+#define CHECK(condition) do { \
+  if (!(condition)) { \
+    printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+    testFailures++; \
+  } \
+} while (0)
+
+#define CHECK_EQUAL(expected, actual) do { \
+  long long expectedValue = (long long) (expected); \
+  long long actualValue = (long long) (actual); \
+  if (expectedValue != actualValue) { \
+    printf("%s:%d: CHECK_EQUAL(%s, %s) failed: %lld != %lld\n", __FILE__, __LINE__, #expected, #actual, expectedValue, actualValue); \
+    testFailures++; \
+  } \
+} while (0)
+
+#define RUN_TEST(test) do { \
+  int failuresBefore = testFailures; \
+  test(); \
+  printf("%s %s\n", (testFailures == failuresBefore) ? "PASS" : "FAIL", #test); \
+} while (0)
+
+#define TEST_RESULT() ((testFailures == 0) ? 0 : 1)
+
+//writes a time to the simulated RTC registers directly, in 24 hour format
+
+static inline void setRegisterTime (TwoWire &bus, byte year, byte month, byte date, byte hour, byte minute, byte second) {
+  bus.registers[0x00] = ((second / 10) << 4) | (second % 10);
+  bus.registers[0x01] = ((minute / 10) << 4) | (minute % 10);
+  bus.registers[0x02] = B10000000 | ((hour / 10) << 4) | (hour % 10); //MIL bit
+  bus.registers[0x03] = ((date / 10) << 4) | (date % 10);
+  bus.registers[0x04] = ((month / 10) << 4) | (month % 10);
+  bus.registers[0x05] = ((year / 10) << 4) | (year % 10);
+}
+
+#endif //end _ISL1208_TEST_H_
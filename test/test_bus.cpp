@@ -0,0 +1,202 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  Bus error handling tests with faults injected in the simulated bus:
+//  retries, backoff, timeout, bus recovery and latency.
+//
+//========================================================================//
+
+#include "test.h"
+#include "ISL1208_RTC.h"
+
+//========================================================================//
+//a NACK on the first transfer is retried instead of failing the call
+
+static void testTransientNack() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  setRegisterTime(bus, 26, 10, 19, 14, 30, 5);
+
+  bus.nackCount = 1;
+  unsigned long transfersBefore = bus.transferCount;
+
+  CHECK(rtc.fetchTime());
+  CHECK_EQUAL(ISL1208_ERROR_NONE, rtc.getLastError());
+  CHECK_EQUAL(5, bus.transferCount - transfersBefore); //1 failed + 2 for the time + 2 for the alarm
+  CHECK_EQUAL(30, rtc.minuteValue);
+}
+
+//========================================================================//
+//a failing transfer is tried once plus the number of retries
+
+static void testRetryCount() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  rtc.setBusTimeout(1000);
+  rtc.setBusRetries(3);
+
+  bus.nackCount = 100;
+  unsigned long transfersBefore = bus.transferCount;
+  CHECK(!rtc.isRtcActive());
+  CHECK_EQUAL(ISL1208_ERROR_ADDRESS_NACK, rtc.getLastError());
+  CHECK_EQUAL(4, bus.transferCount - transfersBefore);
+
+  bus.nackCount = 3; //the last retry succeeds
+  CHECK(rtc.isRtcActive());
+
+  rtc.setBusRetries(0);
+  bus.nackCount = 1;
+  transfersBefore = bus.transferCount;
+  CHECK(rtc.getUserMemory(0) < 0);
+  CHECK_EQUAL(1, bus.transferCount - transfersBefore);
+}
+
+//========================================================================//
+//the delay doubles after each retry, and the total never goes past the
+//timeout by more than one transfer
+
+static void testBackoff() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  rtc.setBusTimeout(100);
+  rtc.setBusRetries(3);
+
+  bus.isPresent = false;
+  CHECK(!rtc.isRtcActive());
+  CHECK_EQUAL((1 + 2 + 4) * 1000 + (4 * bus.transferMicros), rtc.getLastLatency()); //backoffs of 1, 2 and 4 ms
+
+  rtc.setBusTimeout(5);
+  rtc.setBusRetries(50);
+  CHECK(!rtc.isRtcActive());
+  CHECK(rtc.getLastLatency() >= 5000);
+  CHECK(rtc.getLastLatency() <= (5000 + bus.transferMicros)); //no recovery for a NACK
+}
+
+//========================================================================//
+//a bus with SDA held low is clocked free and the transfer is retried. the
+//I2C peripheral must be stopped while the pins are clocked.
+
+static void testRecovery() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  setRegisterTime(bus, 26, 10, 19, 14, 30, 5);
+
+  bus.stuckClocks = 5;
+  CHECK(!rtc.fetchTime()); //no recovery without the pins
+  CHECK_EQUAL(ISL1208_ERROR_TIMEOUT, rtc.getLastError());
+  CHECK_EQUAL(5, bus.stuckClocks);
+
+  unsigned long endsBefore = bus.endCount;
+  unsigned long beginsBefore = bus.beginCount;
+  rtc.setBusPins(20, 21);
+  CHECK(rtc.fetchTime());
+  CHECK_EQUAL(0, bus.stuckClocks);
+  CHECK_EQUAL(1, bus.endCount - endsBefore);
+  CHECK_EQUAL(1, bus.beginCount - beginsBefore);
+  CHECK(bus.isEnabled);
+  CHECK_EQUAL(30, rtc.minuteValue);
+
+  bus.stuckClocks = 20; //more than 9 clocks can't free it
+  CHECK(!rtc.recoverBus());
+  bus.stuckClocks = 0;
+  CHECK(rtc.recoverBus());
+}
+
+//========================================================================//
+//short reads are discarded and retried
+
+static void testShortRead() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  rtc.setBusRetries(0);
+
+  bus.shortReadCount = 1;
+  CHECK(!rtc.isRtcActive());
+  CHECK_EQUAL(ISL1208_ERROR_SHORT_READ, rtc.getLastError());
+
+  rtc.setBusRetries(1);
+  bus.shortReadCount = 1;
+  CHECK(rtc.isRtcActive());
+}
+
+//========================================================================//
+//the latency of a call counts all of its transfers, and a call that uses the
+//bus more than once doesn't start a transfer after its timeout
+
+static void testCallLatency() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  setRegisterTime(bus, 26, 10, 19, 14, 30, 5);
+
+  CHECK(rtc.fetchTime()); //time and alarm reads
+  CHECK_EQUAL(4 * bus.transferMicros, rtc.getLastLatency());
+
+  rtc.setBusTimeout(5);
+  bus.transferMicros = 3000;
+  unsigned long transfersBefore = bus.transferCount;
+  CHECK(!rtc.fetchTime());
+  CHECK_EQUAL(ISL1208_ERROR_TIMEOUT, rtc.getLastError());
+  CHECK_EQUAL(2, bus.transferCount - transfersBefore); //the alarm is not read
+  CHECK_EQUAL(6000, rtc.getLastLatency());
+
+  rtc.setBusTimeout(25);
+  CHECK(rtc.fetchTime());
+  CHECK_EQUAL(12000, rtc.getMaxLatency());
+}
+
+//========================================================================//
+//no call takes longer than the timeout plus one transfer and one recovery,
+//whatever the fault
+
+static void testMaxLatency() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  rtc.setBusTimeout(10);
+  rtc.setBusRetries(255);
+  rtc.setBusPins(20, 21);
+  setRegisterTime(bus, 26, 10, 19, 14, 30, 5);
+
+  for (byte i = 0; i < 20; i++) {
+    bus.nackCount = i * 3;
+    bus.timeoutCount = i % 4;
+    bus.shortReadCount = i % 3;
+    bus.stuckClocks = (i % 5 == 0) ? 30 : 0;
+    bus.isPresent = (i % 7 != 0);
+    rtc.fetchTime();
+    rtc.updateTime();
+    rtc.getUserMemory(0);
+    rtc.set24HourMode(i % 2 == 0);
+    rtc.modifyUserWord(0x00FF, i);
+  }
+
+  CHECK(rtc.getMaxLatency() >= 10000);
+  CHECK(rtc.getMaxLatency() <= (10000 + bus.transferMicros + 1000));
+}
+
+//========================================================================//
+
+int main() {
+  RUN_TEST(testTransientNack);
+  RUN_TEST(testRetryCount);
+  RUN_TEST(testBackoff);
+  RUN_TEST(testRecovery);
+  RUN_TEST(testShortRead);
+  RUN_TEST(testCallLatency);
+  RUN_TEST(testMaxLatency);
+  return TEST_RESULT();
+}
@@ -0,0 +1,138 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  Calendar tests. Every hour of 2000 to 2099 is converted both ways and
+//  compared with gmtime() and timegm() of the C library.
+//
+//========================================================================//
+
+#include <time.h>
+#include "test.h"
+#include "ISL1208_RTC.h"
+#include "ISL1208_EventBuffer.h"
+
+#define UNIX_TIME_2000  946684800LL  //2000-01-01 00:00:00 in seconds since 1970
+
+//========================================================================//
+//fromEpoch(), toEpoch(), dayOfWeek() and daysInMonth() against the C library.
+//the last second of each hour is also checked.
+
+static void testRoundTrip() {
+  unsigned long failureCount = 0;
+
+  for (uint32_t hourCount = 0; hourCount <= (ISL1208_EPOCH_MAX / 3600); hourCount++) {
+    for (uint32_t offset = 0; offset < 3600; offset += 3599) {
+      uint32_t epochTime = (hourCount * 3600) + offset;
+      time_t unixTime = (time_t) (UNIX_TIME_2000 + epochTime);
+      struct tm expected;
+      ISL1208_DateTime dateTime;
+
+      gmtime_r(&unixTime, &expected);
+
+      if (!ISL1208_Calendar::fromEpoch(epochTime, dateTime) ||
+        (dateTime.year != (expected.tm_year - 100)) || (dateTime.month != (expected.tm_mon + 1)) ||
+        (dateTime.date != expected.tm_mday) || (dateTime.hour != expected.tm_hour) ||
+        (dateTime.minute != expected.tm_min) || (dateTime.second != expected.tm_sec) ||
+        (dateTime.day != expected.tm_wday) || !ISL1208_Calendar::isValid(dateTime) ||
+        (ISL1208_Calendar::toEpoch(dateTime) != epochTime) ||
+        ((long long) timegm(&expected) != (long long) unixTime) ||
+        (ISL1208_Calendar::dayOfWeek(dateTime.year, dateTime.month, dateTime.date) != expected.tm_wday)) {
+          if (failureCount++ < 5) {
+            printf("round trip failed at %lu\n", (unsigned long) epochTime);
+          }
+      }
+    }
+  }
+
+  CHECK_EQUAL(0, failureCount);
+}
+
+//========================================================================//
+//the days in every month and the leap years, against the C library
+
+static void testMonths() {
+  for (byte year = 0; year <= 99; year++) {
+    CHECK_EQUAL((year % 4) == 0, ISL1208_Calendar::isLeapYear(year));
+
+    for (byte month = 1; month <= 12; month++) {
+      struct tm nextMonth = {};
+      nextMonth.tm_year = 100 + year + ((month == 12) ? 1 : 0);
+      nextMonth.tm_mon = month % 12;
+      nextMonth.tm_mday = 0; //last day of the previous month
+      timegm(&nextMonth);
+      CHECK_EQUAL(nextMonth.tm_mday, ISL1208_Calendar::daysInMonth(year, month));
+    }
+  }
+}
+
+//========================================================================//
+//values out of range are rejected instead of giving a wrong time
+
+static void testInvalid() {
+  ISL1208_DateTime dateTime = {26, 10, 19, 14, 30, 5, 1};
+  ISL1208_DateTime original = dateTime;
+
+  CHECK_EQUAL(0xFFFF, ISL1208_Calendar::daysSince2000(26, 0, 1));
+  CHECK_EQUAL(0xFFFF, ISL1208_Calendar::daysSince2000(26, 13, 1));
+
+  const byte invalidValues[][6] = {
+    {26, 0, 1, 0, 0, 0}, {26, 13, 1, 0, 0, 0}, {26, 10, 0, 0, 0, 0}, {26, 2, 29, 0, 0, 0},
+    {100, 1, 1, 0, 0, 0}, {26, 10, 19, 24, 0, 0}, {26, 10, 19, 0, 60, 0}, {26, 10, 19, 0, 0, 60},
+    {0x45, 0x45, 0x45, 0x45, 0x45, 0x45} //BCD read as DEC
+  };
+
+  for (byte i = 0; i < (sizeof(invalidValues) / sizeof(invalidValues[0])); i++) {
+    ISL1208_DateTime invalidTime = {invalidValues[i][0], invalidValues[i][1], invalidValues[i][2],
+      invalidValues[i][3], invalidValues[i][4], invalidValues[i][5], 0};
+    CHECK_EQUAL(ISL1208_EPOCH_INVALID, ISL1208_Calendar::toEpoch(invalidTime));
+    CHECK(!ISL1208_Calendar::addSeconds(invalidTime, 1));
+  }
+
+  CHECK(!ISL1208_Calendar::fromEpoch(ISL1208_EPOCH_MAX + 1, dateTime));
+  CHECK(!ISL1208_Calendar::fromEpoch(ISL1208_EPOCH_INVALID, dateTime));
+  CHECK(memcmp(&dateTime, &original, sizeof(dateTime)) == 0);
+
+  CHECK(ISL1208_Calendar::fromEpoch(ISL1208_EPOCH_MAX, dateTime));
+  CHECK_EQUAL(99, dateTime.year);
+  CHECK_EQUAL(31, dateTime.date);
+  CHECK(!ISL1208_Calendar::addSeconds(dateTime, 1));
+}
+
+//========================================================================//
+//an invalid time in the registers is reported instead of being converted
+
+static void testInvalidRegisters() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  ISL1208_TimeZone zone;
+  zone.begin("IST-5:30");
+
+  setRegisterTime(bus, 26, 10, 19, 14, 30, 5);
+  bus.registers[0x04] = 0x00; //month 0
+  CHECK_EQUAL(0, rtc.getEpoch());
+  CHECK_EQUAL(ISL1208_ERROR_INVALID_DATA, rtc.getLastError());
+  CHECK_EQUAL(ISL1208_EPOCH_INVALID, rtc.toEpoch());
+
+  rtc.setTimeZone(&zone);
+  CHECK(!rtc.fetchTime());
+  CHECK_EQUAL(ISL1208_ERROR_INVALID_DATA, rtc.getLastError());
+
+  CHECK(!rtc.fromEpoch(ISL1208_EPOCH_MAX + 1));
+
+  ISL1208_Event storage[4];
+  ISL1208_EventBuffer buffer(rtc, storage, 4);
+  CHECK(!buffer.sync());
+}
+
+//========================================================================//
+
+int main() {
+  RUN_TEST(testRoundTrip);
+  RUN_TEST(testMonths);
+  RUN_TEST(testInvalid);
+  RUN_TEST(testInvalidRegisters);
+  return TEST_RESULT();
+}
@@ -0,0 +1,250 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  Console tests. The commands are played back through the Serial stub.
+//
+//========================================================================//
+
+#include "test.h"
+#include "ISL1208_RTC.h"
+#include "ISL1208_Console.h"
+
+//========================================================================//
+//the day names come from the RTC table
+
+static void testDayNames() {
+  CHECK(strcmp(ISL1208_RTC::getDayName(0), "Sunday") == 0);
+  CHECK(strcmp(ISL1208_RTC::getDayName(6), "Saturday") == 0);
+  CHECK(strcmp(ISL1208_RTC::getDayName(10), "Wednesday") == 0); //wraps around the week
+}
+
+//========================================================================//
+
+static void testPrintDay() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  ISL1208_Console console(rtc, Serial);
+  setRegisterTime(bus, 26, 10, 19, 14, 30, 5);
+  bus.registers[0x06] = 1; //Monday
+
+  Serial.setInput("printday\n");
+  Serial.clearOutput();
+  CHECK(console.poll());
+  CHECK(strstr(Serial.output, "Monday") != NULL);
+
+  rtc.startOfTheWeek = 1; //the week starts on Monday, so day 1 is Tuesday
+  Serial.setInput("printdateday\n");
+  Serial.clearOutput();
+  CHECK(console.poll());
+  CHECK(strstr(Serial.output, "19-10-2026, Tuesday") != NULL);
+}
+
+//========================================================================//
+//a partial line is kept without waiting for the rest, and runs when the
+//line ends
+
+static void testPartialLine() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  ISL1208_Console console(rtc, Serial);
+  setRegisterTime(bus, 26, 10, 19, 14, 30, 5);
+
+  Serial.setInput("print");
+  Serial.clearOutput();
+  CHECK(!console.poll());
+  CHECK_EQUAL(0, Serial.available());
+  CHECK_EQUAL(0, Serial.outputLength);
+
+  Serial.setInput("time\n");
+  CHECK(console.poll());
+  CHECK(strcmp(Serial.output, "2:30:5 PM\r\n") == 0);
+
+  Serial.setInput("\n  \n"); //empty lines are ignored
+  CHECK(!console.poll());
+}
+
+//========================================================================//
+//CR is dropped, so CR+LF lines run the same command
+
+static void testLineEndings() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  ISL1208_Console console(rtc, Serial);
+  setRegisterTime(bus, 26, 10, 19, 14, 30, 5);
+  bus.registers[0x06] = 1; //Monday
+
+  Serial.setInput("printday\r\n");
+  Serial.clearOutput();
+  CHECK(console.poll());
+  CHECK(strcmp(Serial.output, "Monday\r\n") == 0);
+
+  Serial.setInput("printepoch\r");
+  CHECK(!console.poll());
+  Serial.setInput("\n");
+  CHECK(console.poll());
+}
+
+//========================================================================//
+//a line longer than the buffer is dropped as a whole, and the next line
+//works again
+
+static void testOverflow() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  ISL1208_Console console(rtc, Serial);
+  setRegisterTime(bus, 26, 10, 19, 14, 30, 5);
+
+  Serial.setInput("printtime printtime printtime printtime\n");
+  Serial.clearOutput();
+  CHECK(!console.poll());
+  CHECK(strcmp(Serial.output, "Input too long.\r\n") == 0);
+
+  Serial.setInput("settime T26101902300511# printtime\nprintepoch\n");
+  Serial.clearOutput();
+  CHECK(console.poll());
+  CHECK(strcmp(Serial.output, "Input too long.\r\n845735405\r\n") == 0);
+  CHECK_EQUAL(0x30, bus.registers[0x01]); //the time was not set
+}
+
+//========================================================================//
+//unknown commands are reported, and tokens after the third parameter are
+//dropped
+
+static void testTokens() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  ISL1208_Console console(rtc, Serial);
+  setRegisterTime(bus, 26, 10, 19, 14, 30, 5);
+
+  Serial.setInput("settimes T26101902300511#\n");
+  Serial.clearOutput();
+  CHECK(console.poll());
+  CHECK(strcmp(Serial.output, "Unknown command - settimes\r\n") == 0);
+
+  Serial.setInput(" \tprintepoch  a\tb c d e\n");
+  Serial.clearOutput();
+  CHECK(console.poll());
+  CHECK(strcmp(Serial.output, "845735405\r\n") == 0);
+  CHECK_EQUAL(3, console.getParamCount());
+  CHECK(strcmp(console.getParam(0), "a") == 0);
+  CHECK(strcmp(console.getParam(2), "c") == 0);
+  CHECK(strcmp(console.getParam(3), "") == 0);
+
+  Serial.setInput("printepoch\n");
+  CHECK(console.poll());
+  CHECK_EQUAL(0, console.getParamCount());
+  CHECK(strcmp(console.getParam(0), "") == 0);
+}
+
+//========================================================================//
+//the commands that set the RTC registers. the debug messages of the RTC are
+//printed before the console output.
+
+static void testSetCommands() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  ISL1208_Console console(rtc, Serial);
+
+  Serial.setInput("settime T26101902300511#\n");
+  Serial.clearOutput();
+  CHECK(console.poll());
+  CHECK(strstr(Serial.output, "Time updated.\r\n") != NULL);
+  CHECK_EQUAL(0x22, bus.registers[0x02]); //2 PM in 12 hour format
+  CHECK_EQUAL(0x19, bus.registers[0x03]);
+
+  Serial.setInput("settime T261019023005#\n");
+  Serial.clearOutput();
+  CHECK(console.poll());
+  CHECK(strstr(Serial.output, "Time update failed.") != NULL);
+
+  Serial.setInput("setalarm A101902310011#\n");
+  Serial.clearOutput();
+  CHECK(console.poll());
+  CHECK(strstr(Serial.output, "Alarm updated.\r\n") != NULL);
+  CHECK_EQUAL(0x80 | 0x31, bus.registers[0x0D]);
+  CHECK_EQUAL(0x80 | 0x22, bus.registers[0x0E]);
+
+  Serial.setInput("setalarm\n");
+  Serial.clearOutput();
+  CHECK(console.poll());
+  CHECK(strstr(Serial.output, "Alarm update failed.") != NULL);
+
+  Serial.setInput("setepoch 845735465\n"); //one minute later
+  Serial.clearOutput();
+  CHECK(console.poll());
+  CHECK(strcmp(Serial.output, "Time updated.\r\n") == 0);
+  CHECK_EQUAL(0x31, bus.registers[0x01]);
+
+  const char *invalidInputs[] = {"setepoch\n", "setepoch 12x\n", "setepoch 3155760000\n"};
+
+  for (byte i = 0; i < 3; i++) {
+    Serial.setInput(invalidInputs[i]);
+    Serial.clearOutput();
+    CHECK(console.poll());
+    CHECK(strcmp(Serial.output, "Invalid epoch input.\r\n") == 0);
+  }
+
+  CHECK_EQUAL(0x31, bus.registers[0x01]);
+}
+
+//========================================================================//
+//the commands that read the RTC, and the error when it can't be read. the
+//debug messages of the RTC are printed before the console output.
+
+static void testPrintCommands() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  rtc.setBusRetries(0);
+  ISL1208_Console console(rtc, Serial);
+  setRegisterTime(bus, 26, 10, 19, 14, 30, 5);
+  bus.registers[0x07] = ISL1208_SR_WRTC | ISL1208_SR_ALM | ISL1208_SR_RTCF;
+
+  Serial.setInput("printstatus\n");
+  Serial.clearOutput();
+  CHECK(console.poll());
+  CHECK(strcmp(Serial.output, "Status = 0x15 WRTC ALM RTCF\r\n") == 0);
+
+  Serial.setInput("printepoch\n");
+  Serial.clearOutput();
+  CHECK(console.poll());
+  CHECK(strcmp(Serial.output, "845735405\r\n") == 0);
+
+  bus.isPresent = false;
+  const char *readInputs[] = {"printstatus\n", "printepoch\n", "printtime\n"};
+
+  for (byte i = 0; i < 3; i++) {
+    Serial.setInput(readInputs[i]);
+    Serial.clearOutput();
+    CHECK(console.poll());
+    CHECK(strstr(Serial.output, "Error: Could not read RTC. Error code 2\r\n") != NULL);
+  }
+}
+
+//========================================================================//
+
+int main() {
+  RUN_TEST(testDayNames);
+  RUN_TEST(testPrintDay);
+  RUN_TEST(testPartialLine);
+  RUN_TEST(testLineEndings);
+  RUN_TEST(testOverflow);
+  RUN_TEST(testTokens);
+  RUN_TEST(testSetCommands);
+  RUN_TEST(testPrintCommands);
+  return TEST_RESULT();
+}
@@ -0,0 +1,178 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  Duty cycle tests: alarm programming, the checks before sleeping and the
+//  wake up causes.
+//
+//========================================================================//
+
+#include "test.h"
+#include "ISL1208_DutyCycle.h"
+#include "ISL1208_SequenceCounter.h"
+
+#define TEST_EPOCH  845735405UL //2026-10-19 14:30:05 UTC
+
+//========================================================================//
+//the alarm is written and enabled, and read back with the status register
+//in one transfer before the time is checked
+
+static void testSleepUntil() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  setRegisterTime(bus, 26, 10, 19, 14, 30, 5);
+  rtc.set24HourMode(true);
+  bus.registers[0x08] = ISL1208_INT_FOBATB | ISL1208_INT_IM;
+
+  ISL1208_DutyCycle dutyCycle(rtc);
+  unsigned long transfersBefore = bus.transferCount;
+  CHECK(dutyCycle.sleepUntil(TEST_EPOCH + 95)); //14:31:40
+  CHECK_EQUAL(8, bus.transferCount - transfersBefore); //INT, alarm, INT, SR to alarm, time
+
+  CHECK_EQUAL(ISL1208_INT_FOBATB | ISL1208_INT_ALME, bus.registers[0x08]); //single event mode
+  CHECK_EQUAL(0x80 | 0x40, bus.registers[0x0C]);
+  CHECK_EQUAL(0x80 | 0x31, bus.registers[0x0D]);
+  CHECK_EQUAL(0x80 | 0x14, bus.registers[0x0E]); //24 hour format without the MIL bit
+  CHECK_EQUAL(0x80 | 0x19, bus.registers[0x0F]);
+  CHECK_EQUAL(0x80 | 0x10, bus.registers[0x10]);
+  CHECK_EQUAL(0x00, bus.registers[0x11]); //the day is not matched
+
+  CHECK(dutyCycle.sleepFor(1));
+  CHECK_EQUAL(0x80 | 0x06, bus.registers[0x0C]);
+  CHECK_EQUAL(0x80 | 0x30, bus.registers[0x0D]);
+}
+
+//========================================================================//
+//the MCU must not sleep if the wake up time is not later than the RTC time
+
+static void testPastTime() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  setRegisterTime(bus, 26, 10, 19, 14, 30, 5);
+
+  ISL1208_DutyCycle dutyCycle(rtc);
+  CHECK(!dutyCycle.sleepUntil(TEST_EPOCH));
+  CHECK_EQUAL(ISL1208_ERROR_INVALID_DATA, rtc.getLastError());
+  CHECK(!dutyCycle.sleepUntil(TEST_EPOCH - 3600));
+  CHECK(!dutyCycle.sleepFor(0));
+
+  ISL1208_DateTime wakeTime = {26, 10, 19, 14, 30, 5, 0};
+  CHECK(!dutyCycle.sleepUntil(wakeTime));
+  wakeTime.second = 6;
+  CHECK(dutyCycle.sleepUntil(wakeTime));
+  CHECK_EQUAL(ISL1208_ERROR_NONE, rtc.getLastError());
+}
+
+//========================================================================//
+//the alarm has no year, so a wake up time a year or more ahead would match
+//early. February 29 only matches in a leap year.
+
+static void testYearAhead() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  setRegisterTime(bus, 26, 10, 19, 14, 30, 5);
+
+  ISL1208_DutyCycle dutyCycle(rtc);
+  CHECK(!dutyCycle.sleepFor(400UL * 86400));
+  CHECK_EQUAL(ISL1208_ERROR_INVALID_DATA, rtc.getLastError());
+  CHECK(!dutyCycle.sleepFor(365UL * 86400)); //2027-10-19 14:30:05 matches in 2026
+  CHECK(dutyCycle.sleepFor(364UL * 86400));
+
+  ISL1208_DateTime wakeTime = {28, 2, 29, 0, 0, 0, 0};
+  CHECK(dutyCycle.sleepUntil(wakeTime));
+  wakeTime.year = 32;
+  CHECK(!dutyCycle.sleepUntil(wakeTime));
+}
+
+//========================================================================//
+//an alarm that is already pending keeps the IRQ pin low, so the MCU would
+//wake up right away
+
+static void testAlarmPending() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  setRegisterTime(bus, 26, 10, 19, 14, 30, 5);
+  bus.registers[0x07] = ISL1208_SR_WRTC | ISL1208_SR_ALM;
+
+  ISL1208_DutyCycle dutyCycle(rtc);
+  CHECK(!dutyCycle.sleepFor(60));
+
+  CHECK_EQUAL(ISL1208_WAKE_ALARM, dutyCycle.wake());
+  CHECK_EQUAL(0, bus.registers[0x07] & ISL1208_SR_ALM);
+  CHECK(dutyCycle.sleepFor(60));
+}
+
+//========================================================================//
+//the wake up cause comes from a single status register read
+
+static void testWake() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  rtc.setBusRetries(0);
+
+  ISL1208_DutyCycle dutyCycle(rtc);
+  CHECK_EQUAL(ISL1208_WAKE_POWER_FAIL, dutyCycle.wake()); //RTCF on the first power up
+
+  bus.registers[0x07] = ISL1208_SR_WRTC | ISL1208_SR_BAT;
+  unsigned long transfersBefore = bus.transferCount;
+  CHECK_EQUAL(ISL1208_WAKE_BATTERY, dutyCycle.wake());
+  CHECK_EQUAL(2, bus.transferCount - transfersBefore);
+
+  bus.registers[0x07] = ISL1208_SR_WRTC;
+  CHECK_EQUAL(ISL1208_WAKE_OTHER, dutyCycle.wake());
+
+  bus.isPresent = false;
+  CHECK_EQUAL(ISL1208_WAKE_ERROR, dutyCycle.wake());
+  CHECK_EQUAL(4, dutyCycle.getWakeCount());
+}
+
+//========================================================================//
+//with ARST set, a status read clears ALM and BAT on the RTC. the presence
+//probe doesn't read the status, and the flags cleared by other status reads
+//are still reported by wake().
+
+static void testStatusReads() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  bus.registers[0x07] = ISL1208_SR_ARST | ISL1208_SR_WRTC | ISL1208_SR_ALM;
+
+  CHECK(rtc.isRtcActive());
+  CHECK_EQUAL(ISL1208_SR_ALM, bus.registers[0x07] & ISL1208_SR_ALM);
+
+  ISL1208_SequenceCounter counter(rtc);
+  CHECK(counter.begin());
+  CHECK_EQUAL(0, bus.registers[0x07] & ISL1208_SR_ALM); //cleared by the RTC
+
+  ISL1208_DutyCycle dutyCycle(rtc);
+  CHECK_EQUAL(ISL1208_WAKE_ALARM, dutyCycle.wake());
+  CHECK_EQUAL(ISL1208_WAKE_OTHER, dutyCycle.wake()); //reported once
+
+  bus.registers[0x07] = ISL1208_SR_ARST | ISL1208_SR_WRTC | ISL1208_SR_BAT;
+  CHECK(rtc.getStatus() & ISL1208_SR_BAT);
+  CHECK(!(rtc.getStatus() & ISL1208_SR_BAT));
+  CHECK_EQUAL(ISL1208_WAKE_BATTERY, dutyCycle.wake());
+}
+
+//========================================================================//
+
+int main() {
+  RUN_TEST(testSleepUntil);
+  RUN_TEST(testPastTime);
+  RUN_TEST(testYearAhead);
+  RUN_TEST(testAlarmPending);
+  RUN_TEST(testWake);
+  RUN_TEST(testStatusReads);
+  return TEST_RESULT();
+}
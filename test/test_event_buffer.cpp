@@ -0,0 +1,174 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  Event buffer tests: stamping from the cached clock, syncing, overflow
+//  and the byte encoding.
+//
+//========================================================================//
+
+#include "test.h"
+#include "ISL1208_EventBuffer.h"
+
+#define TEST_EPOCH  845735405UL //2026-10-19 14:30:05 UTC
+
+//========================================================================//
+//nothing can be stamped before the first sync, and stamping never reads
+//the RTC to get a time
+
+static void testStampBeforeSync() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  setRegisterTime(bus, 26, 10, 19, 14, 30, 5);
+
+  ISL1208_Event storage[4];
+  ISL1208_EventBuffer buffer(rtc, storage, 4);
+  unsigned long transfersBefore = bus.transferCount;
+
+  CHECK(!buffer.isClockSynced());
+  CHECK_EQUAL(0, buffer.now());
+  CHECK(!buffer.stamp(1));
+  CHECK_EQUAL(0, buffer.available());
+  CHECK_EQUAL(0, buffer.getDroppedCount());
+  CHECK_EQUAL(0, bus.transferCount - transfersBefore);
+}
+
+//========================================================================//
+//a failed sync leaves the buffer unsynced, or keeps the last synced time
+
+static void testSyncFailure() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  rtc.setBusRetries(0);
+  setRegisterTime(bus, 26, 10, 19, 14, 30, 5);
+
+  ISL1208_Event storage[4];
+  ISL1208_EventBuffer buffer(rtc, storage, 4);
+
+  bus.isPresent = false;
+  CHECK(!buffer.sync());
+  CHECK(!buffer.isClockSynced());
+  CHECK(!buffer.stamp(1));
+
+  bus.isPresent = true;
+  CHECK(buffer.sync());
+  CHECK(buffer.isClockSynced());
+  CHECK_EQUAL(TEST_EPOCH, buffer.now());
+
+  bus.registers[0x04] = 0x13; //invalid month
+  CHECK(!buffer.sync());
+  CHECK(buffer.isClockSynced());
+  CHECK_EQUAL(TEST_EPOCH, buffer.now());
+}
+
+//========================================================================//
+//after a sync the cached clock follows millis() without using the bus
+
+static void testStampAfterSync() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  setRegisterTime(bus, 26, 10, 19, 14, 30, 5);
+
+  ISL1208_Event storage[4];
+  ISL1208_EventBuffer buffer(rtc, storage, 4);
+  CHECK(buffer.sync());
+
+  unsigned long transfersBefore = bus.transferCount;
+  CHECK(buffer.stamp(1));
+  stubAdvanceMicros(2500000UL);
+  CHECK(buffer.stamp(2));
+  CHECK_EQUAL(0, bus.transferCount - transfersBefore);
+
+  ISL1208_Event event;
+  CHECK(buffer.pop(event));
+  CHECK_EQUAL(1, event.code);
+  CHECK_EQUAL(TEST_EPOCH, event.timestamp);
+  CHECK(buffer.pop(event));
+  CHECK_EQUAL(2, event.code);
+  CHECK_EQUAL(TEST_EPOCH + 2, event.timestamp);
+  CHECK(!buffer.pop(event));
+}
+
+//========================================================================//
+//a full buffer drops the new events and counts them
+
+static void testOverflow() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  setRegisterTime(bus, 26, 10, 19, 14, 30, 5);
+
+  ISL1208_Event storage[3];
+  ISL1208_EventBuffer buffer(rtc, storage, 3);
+  CHECK(buffer.sync());
+
+  for (uint16_t i = 0; i < 5; i++) {
+    CHECK_EQUAL(i < 3, buffer.stamp(i));
+  }
+
+  CHECK_EQUAL(3, buffer.available());
+  CHECK_EQUAL(2, buffer.getDroppedCount());
+
+  ISL1208_Event event;
+  CHECK(buffer.pop(event));
+  CHECK_EQUAL(0, event.code);
+  CHECK(buffer.stamp(7)); //wraps around
+  CHECK(buffer.pop(event));
+  CHECK(buffer.pop(event));
+  CHECK(buffer.pop(event));
+  CHECK_EQUAL(7, event.code);
+
+  buffer.clear();
+  CHECK_EQUAL(0, buffer.available());
+  CHECK_EQUAL(0, buffer.getDroppedCount());
+}
+
+//========================================================================//
+//events survive the encoding, and only whole events are written
+
+static void testEncodeDecode() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  setRegisterTime(bus, 26, 10, 19, 14, 30, 5);
+
+  ISL1208_Event storage[4];
+  ISL1208_EventBuffer buffer(rtc, storage, 4);
+  CHECK(buffer.sync());
+  CHECK(buffer.stamp(0x1234));
+  stubAdvanceMicros(1000000UL);
+  CHECK(buffer.stamp(0xABCD));
+
+  byte data[(2 * ISL1208_EVENT_SIZE) - 1];
+  CHECK_EQUAL(ISL1208_EVENT_SIZE, buffer.encode(data, sizeof(data)));
+  CHECK_EQUAL(1, buffer.available());
+
+  ISL1208_Event decoded[2];
+  CHECK_EQUAL(1, ISL1208_EventBuffer::decode(data, ISL1208_EVENT_SIZE, decoded, 2));
+  CHECK_EQUAL(0x1234, decoded[0].code);
+  CHECK_EQUAL(TEST_EPOCH, decoded[0].timestamp);
+
+  CHECK_EQUAL(ISL1208_EVENT_SIZE, buffer.encode(data, sizeof(data)));
+  CHECK_EQUAL(1, ISL1208_EventBuffer::decode(data, ISL1208_EVENT_SIZE, decoded, 2));
+  CHECK_EQUAL(0xABCD, decoded[0].code);
+  CHECK_EQUAL(TEST_EPOCH + 1, decoded[0].timestamp);
+}
+
+//========================================================================//
+
+int main() {
+  RUN_TEST(testStampBeforeSync);
+  RUN_TEST(testSyncFailure);
+  RUN_TEST(testStampAfterSync);
+  RUN_TEST(testOverflow);
+  RUN_TEST(testEncodeDecode);
+  return TEST_RESULT();
+}
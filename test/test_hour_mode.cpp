@@ -0,0 +1,133 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  12/24 hour mode tests: conversion of the time and alarm hour registers.
+//
+//========================================================================//
+
+#include "test.h"
+#include "ISL1208_RTC.h"
+
+//========================================================================//
+//both hour registers are converted, and the alarm enable bit is kept
+
+static void testConversion() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  bus.registers[0x02] = 0x23; //3 PM in 12 hour format
+  bus.registers[0x0E] = 0xB1; //11 PM, enabled
+
+  CHECK(rtc.set24HourMode(true));
+  CHECK(rtc.is24HourMode());
+  CHECK_EQUAL(0x95, bus.registers[0x02]); //MIL bit + 15
+  CHECK_EQUAL(0xA3, bus.registers[0x0E]); //enable bit + 23
+
+  CHECK(rtc.set24HourMode(false));
+  CHECK(!rtc.is24HourMode());
+  CHECK_EQUAL(0x23, bus.registers[0x02]);
+  CHECK_EQUAL(0xB1, bus.registers[0x0E]);
+
+  bus.registers[0x02] = 0x12; //12 AM
+  bus.registers[0x0E] = 0x32; //12 PM, disabled
+  CHECK(rtc.set24HourMode(true));
+  CHECK_EQUAL(0x80, bus.registers[0x02]);
+  CHECK_EQUAL(0x12, bus.registers[0x0E]);
+}
+
+//========================================================================//
+//the previous format comes from the MIL bit, so setting the same mode again
+//leaves the registers as they are
+
+static void testRepeatedCall() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  setRegisterTime(bus, 26, 10, 19, 15, 30, 5);
+  bus.registers[0x0E] = 0x95; //15, enabled
+
+  CHECK(rtc.set24HourMode(true));
+  CHECK(rtc.set24HourMode(true));
+  CHECK_EQUAL(0x95, bus.registers[0x02]);
+  CHECK_EQUAL(0x95, bus.registers[0x0E]);
+
+  CHECK(rtc.set24HourMode(false));
+  CHECK(rtc.set24HourMode(false));
+  CHECK_EQUAL(0x23, bus.registers[0x02]);
+  CHECK_EQUAL(0xA3, bus.registers[0x0E]);
+
+  CHECK(rtc.fetchTime());
+  CHECK_EQUAL(3, rtc.hourValue);
+  CHECK_EQUAL(1, rtc.periodValue);
+  CHECK_EQUAL(3, rtc.hourValueAlarm);
+  CHECK_EQUAL(1, rtc.periodValueAlarm);
+}
+
+//========================================================================//
+//the mode is not changed if the registers can't be converted
+
+static void testFailure() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  rtc.setBusRetries(0);
+  bus.registers[0x02] = 0x23;
+
+  bus.isPresent = false;
+  CHECK(!rtc.set24HourMode(true));
+  CHECK(!rtc.is24HourMode());
+  CHECK_EQUAL(ISL1208_ERROR_ADDRESS_NACK, rtc.getLastError());
+  CHECK_EQUAL(0x23, bus.registers[0x02]);
+
+  bus.isPresent = true;
+  CHECK(rtc.set24HourMode(true));
+  CHECK(rtc.is24HourMode());
+}
+
+//========================================================================//
+//after a restart the mode comes from the RTC, so the time and the alarm are
+//written in the format the registers already use
+
+static void testRestart() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  setRegisterTime(bus, 26, 10, 19, 15, 30, 5);
+  CHECK(rtc.set24HourMode(true));
+  CHECK(rtc.setAlarmTime("A101915000001#")); //15:00
+
+  ISL1208_RTC restarted(bus);
+  restarted.begin();
+  CHECK(restarted.is24HourMode());
+  CHECK(restarted.fetchTime());
+  CHECK_EQUAL(15, restarted.hourValue);
+  CHECK_EQUAL(15, restarted.hourValueAlarm);
+
+  CHECK(restarted.updateTime());
+  CHECK_EQUAL(0x95, bus.registers[0x02]);
+  CHECK(restarted.updateAlarmTime());
+  CHECK_EQUAL(0x95, bus.registers[0x0E]);
+
+  CHECK(restarted.set24HourMode(false));
+  ISL1208_RTC restartedAgain(bus);
+  restartedAgain.begin();
+  CHECK(!restartedAgain.is24HourMode());
+  CHECK(restartedAgain.fetchTime());
+  CHECK_EQUAL(3, restartedAgain.hourValue);
+  CHECK_EQUAL(1, restartedAgain.periodValue);
+}
+
+//========================================================================//
+
+int main() {
+  RUN_TEST(testConversion);
+  RUN_TEST(testRepeatedCall);
+  RUN_TEST(testFailure);
+  RUN_TEST(testRestart);
+  return TEST_RESULT();
+}
@@ -0,0 +1,232 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  Redundant RTC tests: voting, failover and resync with a group of three
+//  simulated RTCs on separate buses.
+//
+//========================================================================//
+
+#include "test.h"
+#include "ISL1208_Redundant.h"
+
+#define TEST_EPOCH  845735405UL //2026-10-19 14:30:05 UTC
+
+//========================================================================//
+//three RTCs with the same valid time and the status flags cleared
+
+struct TestGroup {
+  TwoWire bus0, bus1, bus2;
+  ISL1208_RTC rtc0, rtc1, rtc2;
+  TwoWire *buses[3];
+  ISL1208_RTC *rtcList[3];
+
+  TestGroup() : bus0(20, 21), bus1(22, 23), bus2(24, 25), rtc0(bus0), rtc1(bus1), rtc2(bus2) {
+    buses[0] = &bus0;
+    buses[1] = &bus1;
+    buses[2] = &bus2;
+    rtcList[0] = &rtc0;
+    rtcList[1] = &rtc1;
+    rtcList[2] = &rtc2;
+
+    for (byte i = 0; i < 3; i++) {
+      buses[i]->begin();
+      rtcList[i]->begin();
+      rtcList[i]->setBusRetries(0);
+      setRegisterTime(*buses[i], 26, 10, 19, 14, 30, 5);
+      buses[i]->registers[0x07] = ISL1208_SR_WRTC;
+    }
+  }
+};
+
+//returns the time in the registers of an RTC
+
+static uint32_t getRegisterEpoch (ISL1208_RTC &rtc) {
+  uint32_t epochTime = 0;
+  rtc.getEpoch(epochTime);
+  return epochTime;
+}
+
+//========================================================================//
+//each RTC is read in a single transfer, with no presence probe
+
+static void testAgree() {
+  TestGroup group;
+  ISL1208_Redundant redundant(group.rtcList, 3);
+
+  unsigned long transfersBefore[3];
+  for (byte i = 0; i < 3; i++) transfersBefore[i] = group.buses[i]->transferCount;
+
+  CHECK(redundant.update());
+
+  for (byte i = 0; i < 3; i++) {
+    CHECK_EQUAL(ISL1208_HEALTH_OK, redundant.getHealth(i));
+    CHECK_EQUAL(2, group.buses[i]->transferCount - transfersBefore[i]); //register pointer and read
+  }
+
+  CHECK_EQUAL(0, redundant.getActive());
+  CHECK_EQUAL(TEST_EPOCH, redundant.getEpoch());
+
+  CHECK_EQUAL(0, redundant.getFailoverCount());
+  CHECK_EQUAL(0, redundant.getResyncCount());
+}
+
+//========================================================================//
+//the group fails over when the active RTC drops off the bus, and keeps the
+//new one when it comes back
+
+static void testDropOff() {
+  TestGroup group;
+  ISL1208_Redundant redundant(group.rtcList, 3);
+  CHECK(redundant.update());
+
+  group.buses[0]->isPresent = false;
+  CHECK(redundant.update());
+  CHECK_EQUAL(1, redundant.getActive());
+  CHECK_EQUAL(ISL1208_HEALTH_ABSENT, redundant.getHealth(0));
+  CHECK_EQUAL(1, redundant.getFailoverCount());
+  CHECK_EQUAL(0, redundant.getResyncCount()); //an absent RTC can't be resynced
+
+  group.buses[0]->isPresent = true;
+  CHECK(redundant.update());
+  CHECK_EQUAL(1, redundant.getActive());
+  CHECK_EQUAL(ISL1208_HEALTH_OK, redundant.getHealth(0));
+  CHECK_EQUAL(1, redundant.getFailoverCount());
+}
+
+//========================================================================//
+//RTCs with RTCF or BAT set don't vote, and are resynced with the flags
+//cleared. ALM is kept.
+
+static void testFailedFlags() {
+  TestGroup group;
+  ISL1208_Redundant redundant(group.rtcList, 3);
+
+  group.buses[0]->registers[0x07] = ISL1208_SR_WRTC | ISL1208_SR_RTCF;
+  group.buses[0]->registers[0x00] = 0x00; //the time was reset
+  group.buses[0]->registers[0x01] = 0x00;
+  group.buses[2]->registers[0x07] = ISL1208_SR_WRTC | ISL1208_SR_ALM | ISL1208_SR_BAT;
+
+  CHECK(redundant.update());
+  CHECK_EQUAL(1, redundant.getActive());
+  CHECK_EQUAL(ISL1208_HEALTH_FAILED, redundant.getHealth(0));
+  CHECK_EQUAL(ISL1208_HEALTH_FAILED, redundant.getHealth(2));
+  CHECK_EQUAL(2, redundant.getResyncCount());
+
+  CHECK_EQUAL(ISL1208_SR_WRTC, group.buses[0]->registers[0x07]);
+  CHECK_EQUAL(ISL1208_SR_WRTC | ISL1208_SR_ALM, group.buses[2]->registers[0x07]);
+  CHECK_EQUAL(TEST_EPOCH, getRegisterEpoch(*group.rtcList[0]));
+
+  CHECK(redundant.update());
+  for (byte i = 0; i < 3; i++) CHECK_EQUAL(ISL1208_HEALTH_OK, redundant.getHealth(i));
+}
+
+//========================================================================//
+//out of range registers are reported and resynced, unless auto resync is
+//off
+
+static void testInvalidRegisters() {
+  TestGroup group;
+  ISL1208_Redundant redundant(group.rtcList, 3);
+  redundant.setAutoResync(false);
+
+  group.buses[1]->registers[0x04] = 0x13; //month 13
+  CHECK(redundant.update());
+  CHECK_EQUAL(ISL1208_HEALTH_INVALID, redundant.getHealth(1));
+  CHECK_EQUAL(0, redundant.getResyncCount());
+  CHECK_EQUAL(0x13, group.buses[1]->registers[0x04]);
+
+  redundant.setAutoResync(true);
+  CHECK(redundant.update());
+  CHECK_EQUAL(1, redundant.getResyncCount());
+  CHECK_EQUAL(TEST_EPOCH, getRegisterEpoch(*group.rtcList[1]));
+}
+
+//========================================================================//
+//the active RTC is outvoted when the other two agree on a different time
+
+static void testOutvote() {
+  TestGroup group;
+  ISL1208_Redundant redundant(group.rtcList, 3);
+  CHECK(redundant.update());
+
+  group.buses[0]->registers[0x01] = 0x32; //2 minutes ahead
+  CHECK(redundant.update());
+  CHECK_EQUAL(1, redundant.getActive());
+  CHECK_EQUAL(ISL1208_HEALTH_DEVIATED, redundant.getHealth(0));
+  CHECK_EQUAL(1, redundant.getFailoverCount());
+  CHECK_EQUAL(1, redundant.getResyncCount());
+  CHECK_EQUAL(TEST_EPOCH, getRegisterEpoch(*group.rtcList[0]));
+
+  group.buses[2]->registers[0x00] = 0x07; //within the window
+  CHECK(redundant.update());
+  CHECK_EQUAL(ISL1208_HEALTH_OK, redundant.getHealth(2));
+  CHECK_EQUAL(1, redundant.getResyncCount());
+}
+
+//========================================================================//
+//two RTCs that disagree are a tie. the active RTC is kept, but neither time
+//can be trusted, so both are reported and nothing is resynced
+
+static void testTwoDisagree() {
+  TestGroup group;
+  ISL1208_Redundant redundant(group.rtcList, 2);
+  CHECK(redundant.update());
+
+  group.buses[0]->registers[0x01] = 0x32; //2 minutes ahead
+  CHECK(redundant.update());
+  CHECK_EQUAL(0, redundant.getActive());
+  CHECK_EQUAL(ISL1208_HEALTH_DEVIATED, redundant.getHealth(0));
+  CHECK_EQUAL(ISL1208_HEALTH_DEVIATED, redundant.getHealth(1));
+  CHECK_EQUAL(0, redundant.getFailoverCount());
+  CHECK_EQUAL(0, redundant.getResyncCount());
+  CHECK_EQUAL(TEST_EPOCH, getRegisterEpoch(*group.rtcList[1]));
+  CHECK_EQUAL(TEST_EPOCH + 120, getRegisterEpoch(*group.rtcList[0]));
+
+  //with the third RTC the majority is back
+  ISL1208_Redundant fullGroup(group.rtcList, 3);
+  CHECK(fullGroup.update());
+  CHECK_EQUAL(1, fullGroup.getActive());
+  CHECK_EQUAL(ISL1208_HEALTH_DEVIATED, fullGroup.getHealth(0));
+  CHECK_EQUAL(1, fullGroup.getResyncCount());
+  CHECK_EQUAL(TEST_EPOCH, getRegisterEpoch(*group.rtcList[0]));
+}
+
+//========================================================================//
+//with no RTC left the group reports no active RTC
+
+static void testAllAbsent() {
+  TestGroup group;
+  ISL1208_Redundant redundant(group.rtcList, 3);
+
+  for (byte i = 0; i < 3; i++) group.buses[i]->isPresent = false;
+
+  CHECK(!redundant.update());
+  CHECK_EQUAL(ISL1208_RTC_NONE, redundant.getActive());
+  CHECK_EQUAL(0, redundant.getEpoch());
+
+  ISL1208_DateTime dateTime;
+  CHECK(!redundant.getDateTime(dateTime));
+
+  for (byte i = 0; i < 3; i++) {
+    CHECK_EQUAL(ISL1208_HEALTH_ABSENT, redundant.getHealth(i));
+  }
+
+  group.buses[2]->isPresent = true;
+  CHECK(redundant.update());
+  CHECK_EQUAL(2, redundant.getActive());
+  CHECK_EQUAL(0, redundant.getFailoverCount()); //nothing was active
+}
+
+//========================================================================//
+
+int main() {
+  RUN_TEST(testAgree);
+  RUN_TEST(testDropOff);
+  RUN_TEST(testFailedFlags);
+  RUN_TEST(testInvalidRegisters);
+  RUN_TEST(testOutvote);
+  RUN_TEST(testTwoDisagree);
+  RUN_TEST(testAllAbsent);
+  return TEST_RESULT();
+}
@@ -0,0 +1,145 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  Sequence counter tests: loading, block reservation, commit and power
+//  loss in the simulated RTC.
+//
+//========================================================================//
+
+#include "test.h"
+#include "ISL1208_SequenceCounter.h"
+
+//clears RTCF, the same as setting the time after a power loss
+
+static void clearPowerFail (TwoWire &bus) {
+  bus.registers[0x07] &= ~ISL1208_SR_RTCF;
+}
+
+//========================================================================//
+//values continue from the saved limit, and a new block is only reserved
+//when the limit is reached
+
+static void testBlocks() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  clearPowerFail(bus);
+  rtc.setUserWord(100);
+
+  ISL1208_SequenceCounter counter(rtc, 4);
+  CHECK(counter.begin());
+  CHECK_EQUAL(100, counter.peek());
+
+  uint16_t value;
+  CHECK(counter.next(value));
+  CHECK_EQUAL(100, value);
+  CHECK_EQUAL(104, (bus.registers[0x12] << 8) | bus.registers[0x13]);
+
+  unsigned long transfersBefore = bus.transferCount;
+  for (uint16_t i = 101; i < 104; i++) {
+    CHECK(counter.next(value));
+    CHECK_EQUAL(i, value);
+  }
+  CHECK_EQUAL(0, bus.transferCount - transfersBefore);
+
+  CHECK(counter.next(value));
+  CHECK_EQUAL(104, value);
+  CHECK_EQUAL(108, (bus.registers[0x12] << 8) | bus.registers[0x13]);
+}
+
+//========================================================================//
+//a restart with the battery keeps the user memory. the counter continues
+//from the saved limit, or from the exact value after commit()
+
+static void testRestart() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  clearPowerFail(bus);
+  rtc.setUserWord(0);
+
+  uint16_t value;
+  ISL1208_SequenceCounter counter(rtc, 16);
+  CHECK(counter.begin());
+  for (byte i = 0; i < 5; i++) counter.next(value);
+
+  ISL1208_SequenceCounter restarted(rtc, 16);
+  CHECK(restarted.begin());
+  CHECK_EQUAL(16, restarted.peek());
+
+  CHECK(counter.commit());
+  ISL1208_SequenceCounter committed(rtc, 16);
+  CHECK(committed.begin());
+  CHECK_EQUAL(5, committed.peek());
+}
+
+//========================================================================//
+//after a total power loss RTCF is set and the user memory is lost. the
+//counter refuses to load until the time is set again.
+
+static void testPowerLoss() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+
+  uint16_t value;
+  ISL1208_SequenceCounter fresh(rtc);
+  CHECK(!fresh.begin()); //RTCF is set on the first power up
+  CHECK(!fresh.next(value));
+  CHECK_EQUAL(0, bus.registers[0x12]);
+  CHECK_EQUAL(0, bus.registers[0x13]);
+
+  clearPowerFail(bus);
+  rtc.setUserWord(500);
+  ISL1208_SequenceCounter counter(rtc);
+  CHECK(counter.begin());
+  CHECK(counter.next(value));
+  CHECK_EQUAL(500, value);
+
+  bus.registers[0x07] |= ISL1208_SR_RTCF; //power loss
+  bus.registers[0x12] = 0;
+  bus.registers[0x13] = 0;
+  ISL1208_SequenceCounter afterLoss(rtc);
+  CHECK(!afterLoss.begin());
+  CHECK(!afterLoss.next(value));
+  CHECK_EQUAL(0, bus.registers[0x13]);
+
+  rtc.setUserWord(1000); //the application picks a safe start value
+  clearPowerFail(bus);
+  CHECK(afterLoss.begin());
+  CHECK_EQUAL(1000, afterLoss.peek());
+}
+
+//========================================================================//
+//the counter is not loaded if the status can't be read
+
+static void testReadFailure() {
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  rtc.setBusRetries(0);
+  clearPowerFail(bus);
+
+  ISL1208_SequenceCounter counter(rtc);
+  bus.isPresent = false;
+  CHECK(!counter.begin());
+  CHECK(!counter.commit());
+
+  bus.isPresent = true;
+  CHECK(counter.begin());
+}
+
+//========================================================================//
+
+int main() {
+  RUN_TEST(testBlocks);
+  RUN_TEST(testRestart);
+  RUN_TEST(testPowerLoss);
+  RUN_TEST(testReadFailure);
+  return TEST_RESULT();
+}
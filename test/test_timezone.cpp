@@ -0,0 +1,257 @@
+//========================================================================//
+//
+//  ## ISL1208-RTC-Library ##
+//
+//  Time zone tests. The DST changes are checked at known dates and against
+//  the POSIX TZ support of the C library for 2000 to 2099. The RTC tests
+//  check that the registers and epochs stay in UTC while the variables and
+//  the alarm are local.
+//
+//========================================================================//
+
+#include <time.h>
+#include "test.h"
+#include "ISL1208_RTC.h"
+#include "ISL1208_DutyCycle.h"
+#include "ISL1208_EventBuffer.h"
+
+#define UNIX_TIME_2000  946684800LL  //2000-01-01 00:00:00 in seconds since 1970
+
+#define US_EASTERN  "EST5EDT,M3.2.0,M11.1.0"
+#define EUROPE      "CET-1CEST,M3.5.0,M10.5.0/3"
+#define SYDNEY      "AEST-10AEDT,M10.1.0,M4.1.0/3"
+#define INDIA       "IST-5:30"
+
+static uint32_t toEpoch (byte year, byte month, byte date, byte hour, byte minute, byte second) {
+  ISL1208_DateTime dateTime = {year, month, date, hour, minute, second, 0};
+  return ISL1208_Calendar::toEpoch(dateTime);
+}
+
+//========================================================================//
+//checks the offset just before and at a DST change given in UTC
+
+static void checkChange (const char *tzString, uint32_t changeTime, int32_t offsetBefore, int32_t offsetAfter) {
+  ISL1208_TimeZone zone;
+  CHECK(zone.begin(tzString));
+  CHECK_EQUAL(offsetBefore, zone.getOffset(changeTime - 1));
+  CHECK_EQUAL(offsetAfter, zone.getOffset(changeTime));
+  CHECK_EQUAL(changeTime - 1 + offsetBefore, zone.toLocal(changeTime - 1));
+  CHECK_EQUAL(changeTime + offsetAfter, zone.toLocal(changeTime));
+}
+
+//========================================================================//
+//the 2026 DST changes
+
+static void testKnownChanges() {
+  checkChange(US_EASTERN, toEpoch(26, 3, 8, 7, 0, 0), -5 * 3600, -4 * 3600); //02:00 EST
+  checkChange(US_EASTERN, toEpoch(26, 11, 1, 6, 0, 0), -4 * 3600, -5 * 3600); //02:00 EDT
+  checkChange(EUROPE, toEpoch(26, 3, 29, 1, 0, 0), 3600, 7200); //02:00 CET
+  checkChange(EUROPE, toEpoch(26, 10, 25, 1, 0, 0), 7200, 3600); //03:00 CEST
+  checkChange(SYDNEY, toEpoch(26, 4, 4, 16, 0, 0), 11 * 3600, 10 * 3600); //03:00 AEDT
+  checkChange(SYDNEY, toEpoch(26, 10, 3, 16, 0, 0), 10 * 3600, 11 * 3600); //02:00 AEST
+
+  //the skipped hour is taken as standard time and the repeated hour as DST
+  ISL1208_TimeZone zone;
+  zone.begin(EUROPE);
+  CHECK_EQUAL(toEpoch(26, 3, 29, 1, 30, 0), zone.toUtc(toEpoch(26, 3, 29, 2, 30, 0)));
+  CHECK_EQUAL(toEpoch(26, 10, 25, 0, 30, 0), zone.toUtc(toEpoch(26, 10, 25, 2, 30, 0)));
+}
+
+//========================================================================//
+//every hour and the last second before it, against localtime() with the
+//same TZ string. toUtc() must give a UTC time with the same local time.
+
+static void testAgainstLibc() {
+  const char *tzStrings[] = {US_EASTERN, EUROPE, SYDNEY, INDIA, "NZST-12NZDT,M9.5.0,M4.1.0/3", "<-03>3"};
+
+  for (byte i = 0; i < (sizeof(tzStrings) / sizeof(tzStrings[0])); i++) {
+    ISL1208_TimeZone zone;
+    unsigned long failureCount = 0;
+
+    CHECK(zone.begin(tzStrings[i]));
+    setenv("TZ", tzStrings[i], 1);
+    tzset();
+
+    for (uint32_t utcTime = 86400; utcTime < (ISL1208_EPOCH_MAX - 86400); utcTime += 3600) {
+      for (int8_t shift = -1; shift <= 0; shift++) {
+        uint32_t testTime = utcTime + shift;
+        time_t unixTime = (time_t) (UNIX_TIME_2000 + testTime);
+        struct tm expected;
+        localtime_r(&unixTime, &expected);
+
+        uint32_t localTime = zone.toLocal(testTime);
+        uint32_t backTime = zone.toUtc(localTime);
+
+        if ((localTime != (uint32_t) (testTime + expected.tm_gmtoff)) || (zone.isDst(testTime) != (expected.tm_isdst > 0)) ||
+          (zone.toLocal(backTime) != localTime)) {
+            if (failureCount++ < 5) {
+              printf("%s: mismatch at %lu\n", tzStrings[i], (unsigned long) testTime);
+            }
+        }
+      }
+    }
+
+    CHECK_EQUAL(0, failureCount);
+  }
+
+  unsetenv("TZ");
+  tzset();
+}
+
+//========================================================================//
+//times that fall outside 2000 to 2099 after the conversion are rejected
+
+static void testRange() {
+  ISL1208_TimeZone zone;
+  zone.begin(INDIA);
+
+  ISL1208_DateTime dateTime = {0, 1, 1, 1, 0, 0, 6}; //2000-01-01 01:00 local is 1999 in UTC
+  ISL1208_DateTime original = dateTime;
+  CHECK(!zone.toUtc(dateTime));
+  CHECK(memcmp(&dateTime, &original, sizeof(dateTime)) == 0);
+  CHECK_EQUAL(ISL1208_EPOCH_INVALID, zone.toUtc((uint32_t) 3600));
+  CHECK_EQUAL(ISL1208_EPOCH_INVALID, zone.toLocal(ISL1208_EPOCH_MAX));
+  CHECK_EQUAL(ISL1208_EPOCH_INVALID, zone.toLocal(ISL1208_EPOCH_INVALID));
+  CHECK_EQUAL(19800, zone.toLocal((uint32_t) 0));
+
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  rtc.set24HourMode(true);
+  rtc.setTimeZone(&zone);
+  setRegisterTime(bus, 26, 10, 19, 12, 0, 0);
+
+  rtc.yearValue = 0;
+  rtc.monthValue = 1;
+  rtc.dateValue = 1;
+  rtc.hourValue = 1;
+  rtc.minuteValue = 0;
+  rtc.secondValue = 0;
+  CHECK(!rtc.updateTime());
+  CHECK_EQUAL(ISL1208_ERROR_INVALID_DATA, rtc.getLastError());
+  CHECK_EQUAL(0x26, bus.registers[0x05]); //not written
+  CHECK(!rtc.setTime("T00010101000001#"));
+
+  setRegisterTime(bus, 99, 12, 31, 23, 0, 0); //2099-12-31 23:00 UTC is 2100 in local time
+  CHECK(!rtc.fetchTime());
+  CHECK_EQUAL(ISL1208_ERROR_INVALID_DATA, rtc.getLastError());
+  CHECK(!rtc.fromEpoch(ISL1208_EPOCH_MAX));
+}
+
+//========================================================================//
+//the registers and epochs are UTC, the variables and strings are local
+
+static void testRtcTime() {
+  ISL1208_TimeZone zone;
+  zone.begin(EUROPE);
+
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  rtc.set24HourMode(true);
+  rtc.setTimeZone(&zone);
+
+  setRegisterTime(bus, 26, 10, 25, 0, 30, 0); //CEST, 02:30 local
+  uint32_t firstTime = toEpoch(26, 10, 25, 0, 30, 0);
+  CHECK_EQUAL(firstTime, rtc.getEpoch());
+  CHECK(rtc.fetchTime());
+  CHECK_EQUAL(2, rtc.hourValue);
+  CHECK(rtc.getTimeString() == "2:30:0");
+  CHECK_EQUAL(firstTime, rtc.toEpoch());
+
+  setRegisterTime(bus, 26, 10, 25, 1, 30, 0); //CET, 02:30 local again
+  CHECK_EQUAL(firstTime + 3600, rtc.getEpoch()); //the epoch doesn't repeat
+  CHECK(rtc.fetchTime());
+  CHECK_EQUAL(2, rtc.hourValue);
+
+  CHECK(rtc.setEpoch(firstTime + 3600)); //written as UTC, not through the local time
+  CHECK_EQUAL(0x01, bus.registers[0x02] & B00111111);
+
+  CHECK(rtc.fromEpoch(toEpoch(26, 7, 1, 10, 0, 0))); //summer, UTC+2
+  CHECK_EQUAL(12, rtc.hourValue);
+  CHECK(rtc.updateTime());
+  CHECK_EQUAL(0x10, bus.registers[0x02] & B00111111);
+  CHECK_EQUAL(0x07, bus.registers[0x04]);
+
+  ISL1208_Event storage[4];
+  ISL1208_EventBuffer buffer(rtc, storage, 4);
+  CHECK(buffer.sync());
+  CHECK(buffer.stamp(1));
+  ISL1208_Event event;
+  CHECK(buffer.pop(event));
+  CHECK_EQUAL(toEpoch(26, 7, 1, 10, 0, 0), event.timestamp);
+}
+
+//========================================================================//
+//the alarm is written in UTC with the offset of its next match and read
+//back as the same local time. the duty cycle helper writes the same values.
+
+static void testRtcAlarm() {
+  ISL1208_TimeZone zone;
+  zone.begin(EUROPE);
+
+  TwoWire bus(20, 21);
+  bus.begin();
+  ISL1208_RTC rtc(bus);
+  rtc.begin();
+  rtc.set24HourMode(true);
+  rtc.setTimeZone(&zone);
+  setRegisterTime(bus, 26, 10, 19, 10, 0, 0); //CEST
+
+  CHECK(rtc.setAlarmTime("A111012000000#")); //10 November 12:00, CET
+  CHECK_EQUAL(0x80 | 0x11, bus.registers[0x0E] & 0xBF); //11:00 UTC
+  CHECK_EQUAL(0x80 | 0x10, bus.registers[0x0F]);
+  CHECK_EQUAL(0x80 | 0x11, bus.registers[0x10]);
+
+  CHECK(rtc.fetchTime());
+  CHECK_EQUAL(12, rtc.hourValueAlarm);
+  CHECK_EQUAL(10, rtc.dateValueAlarm);
+  CHECK_EQUAL(11, rtc.monthValueAlarm);
+
+  rtc.hourValueAlarm = 12; //20 October 12:00, CEST
+  rtc.dateValueAlarm = 20;
+  rtc.monthValueAlarm = 10;
+  CHECK(rtc.updateAlarmTime());
+  CHECK_EQUAL(0x80 | 0x10, bus.registers[0x0E] & 0xBF);
+  CHECK(rtc.fetchTime());
+  CHECK_EQUAL(12, rtc.hourValueAlarm);
+
+  rtc.hourValueAlarm = 0; //1 January 00:30 is in the next year, and the UTC date is 31 December
+  rtc.minuteValueAlarm = 30;
+  rtc.dateValueAlarm = 1;
+  rtc.monthValueAlarm = 1;
+  CHECK(rtc.updateAlarmTime());
+  CHECK_EQUAL(0x80 | 0x23, bus.registers[0x0E] & 0xBF);
+  CHECK_EQUAL(0x80 | 0x31, bus.registers[0x0F]);
+  CHECK_EQUAL(0x80 | 0x12, bus.registers[0x10]);
+  CHECK(rtc.fetchTime());
+  CHECK_EQUAL(0, rtc.hourValueAlarm);
+  CHECK_EQUAL(1, rtc.dateValueAlarm);
+  CHECK_EQUAL(1, rtc.monthValueAlarm);
+
+  CHECK(rtc.setAlarmTime("A111012000000#"));
+  byte alarmData[5];
+  memcpy(alarmData, bus.registers + 0x0C, 5);
+
+  ISL1208_DutyCycle dutyCycle(rtc);
+  ISL1208_DateTime wakeTime = {26, 11, 10, 12, 0, 0, 0};
+  CHECK(dutyCycle.sleepUntil(wakeTime));
+  CHECK(memcmp(alarmData, bus.registers + 0x0C, 5) == 0);
+
+  CHECK(dutyCycle.sleepFor(3600)); //the duration is added in UTC
+  CHECK_EQUAL(0x80 | 0x11, bus.registers[0x0E] & 0xBF);
+  CHECK_EQUAL(0x80 | 0x19, bus.registers[0x0F]);
+}
+
+//========================================================================//
+
+int main() {
+  RUN_TEST(testKnownChanges);
+  RUN_TEST(testAgainstLibc);
+  RUN_TEST(testRange);
+  RUN_TEST(testRtcTime);
+  RUN_TEST(testRtcAlarm);
+  return TEST_RESULT();
+}